@@ -11,10 +11,10 @@ int main(int argc, char **argv) {
     CHECK(argc >= 4);
     FILE *fileA = fopen(argv[1], "r"); CHECK(fileA);
     FILE *fileB = fopen(argv[2], "r"); CHECK(fileB);
-    real xA, yA, zA, xB, yB, zB, tA, tB, cpuA, cpuB;
+    long double xA, yA, zA, xB, yB, zB, tA, tB, cpuA, cpuB;
     char *format = "%Le %Le %Le %Le %1s %1s %1s %Le", tag[2];
     for (int i = 3; i < argc; i++) {
-        real threshold = strtold(argv[i], NULL);
+        long double threshold = strtold(argv[i], NULL);
         while(fscanf(fileA, format, &xA, &yA, &zA, &tA, tag, tag, tag, &cpuA) != EOF &&
               fscanf(fileB, format, &xB, &yB, &zB, &tB, tag, tag, tag, &cpuB) != EOF) {
             CHECK(tB == tA);
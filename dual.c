@@ -7,25 +7,25 @@
 #include "dual.h"
 
 dual d_dual (real a) {
-    return (dual){.val = a, .dot = 0.0L};
+    return (dual){.val = a, .dot = RL(0.0)};
 }
 
 dual d_var (real a) {
-    return (dual){.val = a, .dot = 1.0L};
+    return (dual){.val = a, .dot = RL(1.0)};
 }
 
 dual d_abs (const dual a) {
-    CHECK(a.val != 0.0L);
-    return (dual){.val = a.val < 0.0L ? - a.val : a.val, .dot = a.val < 0.0L ? - a.dot : a.dot};
+    CHECK(a.val != RL(0.0));
+    return (dual){.val = a.val < RL(0.0) ? - a.val : a.val, .dot = a.val < RL(0.0) ? - a.dot : a.dot};
 }
 
 dual d_rec (const dual b) {
-    CHECK(b.val != 0.0L);
-    return (dual){.val = 1.0L / b.val, .dot = - b.dot / SQR(b.val)};
+    CHECK(b.val != RL(0.0));
+    return (dual){.val = RL(1.0) / b.val, .dot = - b.dot / SQR(b.val)};
 }
 
 dual d_sqr (const dual a) {
-    return (dual){.val = SQR(a.val), .dot = 2.0L * a.val * a.dot};
+    return (dual){.val = SQR(a.val), .dot = RL(2.0) * a.val * a.dot};
 }
 
 dual d_shift (const dual a, real b) {
@@ -49,82 +49,82 @@ dual d_mul (const dual a, dual b) {
 }
 
 dual d_div (const dual a, dual b) {
-    CHECK(b.val != 0.0L);
+    CHECK(b.val != RL(0.0));
     return (dual){.val = a.val / b.val, .dot = (a.dot * b.val - a.val * b.dot) / SQR(b.val)};
 }
 
 dual d_exp (const dual a) {
-    real exp = expl(a.val);
-    return (dual){.val = exp, .dot = a.dot * exp};
+    real e = EXP(a.val);
+    return (dual){.val = e, .dot = a.dot * e};
 }
 
 dual d_ln (const dual a) {
-    CHECK(a.val > 0.0L);
-    return (dual){.val = logl(a.val), .dot = a.dot / a.val};
+    CHECK(a.val > RL(0.0));
+    return (dual){.val = LOG(a.val), .dot = a.dot / a.val};
 }
 
 dual d_sqrt (const dual a) {
-    CHECK(a.val > 0.0L);
-    real sqrt = sqrtl(a.val);
-    return (dual){.val = sqrt, .dot = a.dot * 0.5L / sqrt};
+    CHECK(a.val > RL(0.0));
+    real root = SQRT(a.val);
+    return (dual){.val = root, .dot = a.dot * RL(0.5) / root};
 }
 
 dual d_pow (const dual a, real b) {
-    CHECK(a.val > 0.0L);
-    real pow = powl(a.val, b);
-    return (dual){.val = pow, .dot = a.dot * b * pow / a.val};
+    CHECK(a.val > RL(0.0));
+    real p = POW(a.val, b);
+    return (dual){.val = p, .dot = a.dot * b * p / a.val};
 }
 
 dual d_sin (const dual a) {
-    return (dual){.val = sinl(a.val), .dot = a.dot * cosl(a.val)};
+    return (dual){.val = SIN(a.val), .dot = a.dot * COS(a.val)};
 }
 
 dual d_cos (const dual a) {
-    return (dual){.val = cosl(a.val), .dot = - a.dot * sinl(a.val)};
+    return (dual){.val = COS(a.val), .dot = - a.dot * SIN(a.val)};
 }
 
 dual d_tan (const dual a) {
-    real tan = tanl(a.val);
-    return (dual){.val = tan, .dot = a.dot * (1.0L + SQR(tan))};
+    real t = TAN(a.val);
+    return (dual){.val = t, .dot = a.dot * (RL(1.0) + SQR(t))};
 }
 
 dual d_sinh (const dual a) {
-    return (dual){.val = sinhl(a.val), .dot = a.dot * coshl(a.val)};
+    return (dual){.val = SINH(a.val), .dot = a.dot * COSH(a.val)};
 }
 
 dual d_cosh (const dual a) {
-    return (dual){.val = coshl(a.val), .dot = a.dot * sinhl(a.val)};
+    return (dual){.val = COSH(a.val), .dot = a.dot * SINH(a.val)};
 }
 
 dual d_tanh (const dual a) {
-    real tanh = tanhl(a.val);
-    return (dual){.val = tanh, .dot = a.dot * (1.0L - SQR(tanh))};
+    real t = TANH(a.val);
+    return (dual){.val = t, .dot = a.dot * (RL(1.0) - SQR(t))};
 }
 
 dual d_asin (const dual a) {
-    CHECK(a.val > -1.0L && a.val < 1.0L);
-    return (dual){.val = asinl(a.val), .dot = a.dot / sqrtl(1.0L - SQR(a.val))};
+    CHECK(a.val > -RL(1.0) && a.val < RL(1.0));
+    return (dual){.val = ASIN(a.val), .dot = a.dot / SQRT(RL(1.0) - SQR(a.val))};
 }
 
 dual d_acos (const dual a) {
-    CHECK(a.val > -1.0L && a.val < 1.0L);
-    return (dual){.val = acosl(a.val), .dot = - a.dot / sqrtl(1.0L - SQR(a.val))};
+    CHECK(a.val > -RL(1.0) && a.val < RL(1.0));
+    return (dual){.val = ACOS(a.val), .dot = - a.dot / SQRT(RL(1.0) - SQR(a.val))};
 }
 
 dual d_atan (const dual a) {
-    return (dual){.val = atanl(a.val), .dot = a.dot / (1.0L + SQR(a.val))};
+    return (dual){.val = ATAN(a.val), .dot = a.dot / (RL(1.0) + SQR(a.val))};
 }
 
 dual d_asinh (const dual a) {
-    return (dual){.val = asinhl(a.val), .dot = a.dot / sqrtl(SQR(a.val) + 1.0L)};
+    return (dual){.val = ASINH(a.val), .dot = a.dot / SQRT(SQR(a.val) + RL(1.0))};
 }
 
 dual d_acosh (const dual a) {
-    CHECK(a.val > 1.0L);
-    return (dual){.val = acoshl(a.val), .dot = a.dot / sqrtl(SQR(a.val) - 1.0L)};
+    CHECK(a.val > RL(1.0));
+    return (dual){.val = ACOSH(a.val), .dot = a.dot / SQRT(SQR(a.val) - RL(1.0))};
 }
 
 dual d_atanh (const dual a) {
-    CHECK(a.val > -1.0L && a.val < 1.0L);
-    return (dual){.val = atanhl(a.val), .dot = a.dot / (1.0L - SQR(a.val))};
+    CHECK(a.val > -RL(1.0) && a.val < RL(1.0));
+    return (dual){.val = ATANH(a.val), .dot = a.dot / (RL(1.0) - SQR(a.val))};
 }
@@ -12,23 +12,27 @@ struct Parameters { real c, d; };
 model *symp_init_p (int argc, char **argv) { (void)argc; (void)argv;
     CHECK(argc == 5);
     model *_ = malloc(sizeof (model)); CHECK(_);
-    _->c = 0.0L;
-    _->d = 0.0L;
+    _->c = RL(0.0);
+    _->d = RL(0.0);
     return _;
 }
 
-static void plot (int dp, model *p, real t) { (void)dp; (void)t;
-    printf("% .3Le % .3Le\n", p->c, p->d);
+static void plot (const controls *c, model *p, real t) { (void)c; (void)t;
+    printf("% .3Le % .3Le\n", (long double)p->c, (long double)p->d);
+}
+
+block symp_state (model *p) {
+    return (block){p, sizeof (model)};
 }
 
 void update_q (model *p, real c) {
     p->c += c;
-    plot(0L, p, 0.0L);
+    plot(NULL, p, RL(0.0));
 }
 
 void update_p (model *p, real d) {
     p->d += d;
-    plot(0L, p, 0.0L);
+    plot(NULL, p, RL(0.0));
 }
 
 int main (int argc, char **argv) {
@@ -14,7 +14,7 @@ typedef struct Matrix3x3 { real a, b, c, d, e, f, g, h, i; } matrix3x3;
 
 static real det2x2 (real a, real d, real b, real c) {
     real w = b * c;
-    return fmal(a, d, -w) + fmal(-b, c, w);
+    return FMA(a, d, -w) + FMA(-b, c, w);
 }
 
 static matrix3x3 m_invert (matrix3x3 m) {
@@ -24,7 +24,7 @@ static matrix3x3 m_invert (matrix3x3 m) {
         .g =  det2x2(m.b, m.f, m.c, m.e), .h = -det2x2(m.a, m.f, m.c, m.d), .i =  det2x2(m.a, m.e, m.b, m.d)
     };
     real d = m.a * c.a + m.b * c.b + m.c * c.c;
-    CHECK(d != 0.0L);
+    CHECK(d != RL(0.0));
     return (matrix3x3){
         .a = c.a / d, .b = c.d / d, .c = c.g / d,
         .d = c.b / d, .e = c.e / d, .f = c.h / d,
@@ -49,37 +49,37 @@ static vector3 v_sub (vector3 u, vector3 v) {
 }
 
 static bool converged (vector3 v, real epsilon) {
-    return fabsl(v.a) < epsilon && fabsl(v.b) < epsilon && fabsl(v.c) < epsilon;
+    return FABS(v.a) < epsilon && FABS(v.b) < epsilon && FABS(v.c) < epsilon;
 }
 
 static dual R (real r, dual E, dual L, dual Q, real a) {
     real ra2 = SQR(r) + SQR(a);
     return d_sub(d_sqr(d_sub(d_scale(E, ra2), d_scale(L, a))),
-                 d_scale(d_add(d_sqr(d_sub(L, d_scale(E, a))), d_shift(Q, SQR(r))), ra2 - 2.0L * r));
+                 d_scale(d_add(d_sqr(d_sub(L, d_scale(E, a))), d_shift(Q, SQR(r))), ra2 - RL(2.0) * r));
 }
 
 static dual dR_dr (real r, dual E, dual L, dual Q, real a) {
     real ra2 = SQR(r) + SQR(a);
-    return d_sub(d_scale(d_mul(E, d_sub(d_scale(E, ra2), d_scale(L, a))), 4.0L * r),
-                 d_shift(d_scale(d_shift(d_add(Q, d_sqr(d_sub(L, d_scale(E, a)))), SQR(r)), 2.0L * r - 2.0L),
-                         2.0L * r * (ra2 - 2.0L * r)));
+    return d_sub(d_scale(d_mul(E, d_sub(d_scale(E, ra2), d_scale(L, a))), RL(4.0) * r),
+                 d_shift(d_scale(d_shift(d_add(Q, d_sqr(d_sub(L, d_scale(E, a)))), SQR(r)), RL(2.0) * r - RL(2.0)),
+                         RL(2.0) * r * (ra2 - RL(2.0) * r)));
 }
 
 static dual THETA (real theta, dual E, dual L, dual Q, real a) {
-    real sth2 = SQR(sinl(theta));
-    return d_sub(Q, d_scale(d_add(d_scale(d_shift(d_sqr(E), - 1.0L), - SQR(a)), d_scale(d_sqr(L), 1.0L / sth2)), 1.0L - sth2));
+    real sth2 = SQR(SIN(theta));
+    return d_sub(Q, d_scale(d_add(d_scale(d_shift(d_sqr(E), - RL(1.0)), - SQR(a)), d_scale(d_sqr(L), RL(1.0) / sth2)), RL(1.0) - sth2));
 }
 
 static model *get_p_gen (char **argv) {
     model *_ = malloc(sizeof (model)); CHECK(_);
-    _->epsilon = strtold(argv[1], NULL);
-    _->rmin = strtold(argv[2], NULL);
-    _->rmax = strtold(argv[3], NULL);
-    _->thmax = elevation_to_colatitude(strtold(argv[4], NULL));
-    _->a = strtold(argv[5], NULL);
-    _->E = 1.0L;
-    _->L = 5.0L;
-    _->Q = 0.0L;
+    _->epsilon = STRTOR(argv[1], NULL);
+    _->rmin = STRTOR(argv[2], NULL);
+    _->rmax = STRTOR(argv[3], NULL);
+    _->thmax = elevation_to_colatitude(STRTOR(argv[4], NULL));
+    _->a = STRTOR(argv[5], NULL);
+    _->E = RL(1.0);
+    _->L = RL(5.0);
+    _->Q = RL(0.0);
     return _;
 }
 
@@ -88,9 +88,9 @@ int main (int argc, char **argv) { (void)argc;
     CHECK(argc == 6);
     model *k = get_p_gen(argv);
     matrix3x3 J;
-    vector3 x = {k->E, k->L, k->Q}, f = {1.0L, 1.0L, 1.0L};
+    vector3 x = {k->E, k->L, k->Q}, f = {RL(1.0), RL(1.0), RL(1.0)};
     long count = 0L;
-    bool circular = k->rmin * k->rmax < 0.0L;
+    bool circular = k->rmin * k->rmax < RL(0.0);
     while (!converged(f, k->epsilon)) {
         J = (matrix3x3){
             .a = R(k->rmin,  d_var(k->E), d_dual(k->L), d_dual(k->Q), k->a).dot,
@@ -116,7 +116,7 @@ int main (int argc, char **argv) { (void)argc;
             f.b = dR_dr(k->rmin, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val;
         }
         x = v_sub(x, mv_mult(m_invert(J), f));
-        fprintf(stderr, "%.18Lf %.18Lf %.18Lf\n", x.a, x.b, x.c);
+        fprintf(stderr, "%.18Lf %.18Lf %.18Lf\n", (long double)x.a, (long double)x.b, (long double)x.c);
         k->E = x.a;
         k->L = x.b;
         k->Q = x.c;
@@ -124,16 +124,16 @@ int main (int argc, char **argv) { (void)argc;
     }
     bool valid = true;
     if (!circular) {
-        valid = ! (dR_dr(k->rmin, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val < 0.0L &&
-                   dR_dr(k->rmax, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val > 0.0L);
+        valid = ! (dR_dr(k->rmin, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val < RL(0.0) &&
+                   dR_dr(k->rmax, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val > RL(0.0));
     }
     fprintf(stderr, "%.ld iterations, precision %.1Le %s\n",
-            count, k->epsilon, valid ? (k->a * k->L < 0.0L ? "RETROGRADE" : "PROGRADE") : "INVALID");
+            count, (long double)k->epsilon, valid ? (k->a * k->L < RL(0.0) ? "RETROGRADE" : "PROGRADE") : "INVALID");
     fprintf(stderr, "\nSimulate:\n");
     fprintf(stderr, "./h-kerr-std 6 8 .01 10000 0 %.3Lf %.9Le %.9Le 1.0 %.9Le %.3Lf 0.0 >/tmp/$USER/data\n",
-            k->a, k->E, k->L, k->Q, circular ? k->rmin : 0.5L * (k->rmin + k->rmax));
+            (long double)k->a, (long double)k->E, (long double)k->L, (long double)k->Q, (long double)(circular ? k->rmin : RL(0.5) * (k->rmin + k->rmax)));
     fprintf(stderr, "\n./h-kerr-std 6 8 .01 10000 0 %.3Lf %La %La 1.0 %La %.3Lf 0.0 >/tmp/$USER/data\n",
-            k->a, k->E, k->L, k->Q, circular ? k->rmin : 0.5L * (k->rmin + k->rmax));
+            (long double)k->a, (long double)k->E, (long double)k->L, (long double)k->Q, (long double)(circular ? k->rmin : RL(0.5) * (k->rmin + k->rmax)));
     fprintf(stderr, "\n./h-kerr-gl $(yad --columns=2 --title='Kerr Particle Orbit GL' --form --separator=' ' --align=right ");
     fprintf(stderr, "--field='Trail Length':NUM --field='Order':NUM --field='Step Size':NUM --field='Steps':NUM ");
     fprintf(stderr, "--field='BH spin':NUM --field='particle mass':RO ");
@@ -141,16 +141,16 @@ int main (int argc, char **argv) { (void)argc;
     fprintf(stderr, "--field='r0' --field='theta0' ");
     fprintf(stderr, "-- '2000!1000..10000!1000' '4!2..10!2' '.01!0.001..0.1!0.001!3' '10000!1..1000000!1000' "),
     fprintf(stderr, "'%.3Lf!-1.0..1.0!0.1!1' 1.0 %.9Le %.9Le 1.0 %.9Le %.3Lf 0.0)\n",
-            k->a, k->E, k->L, k->Q, circular ? k->rmin : 0.5L * (k->rmin + k->rmax));
+            (long double)k->a, (long double)k->E, (long double)k->L, (long double)k->Q, (long double)(circular ? k->rmin : RL(0.5) * (k->rmin + k->rmax)));
 
-    real r_range = (circular ? k->rmin + 1.0L : k->rmax + 1.0L);
-    real PI = acosl(-1.0L);
+    real r_range = (circular ? k->rmin + RL(1.0) : k->rmax + RL(1.0));
+    real PI = ACOS(-RL(1.0));
     for (int i = 1; i < 1000; i++) {
-        real r = r_range * i / 1000.0L;
-        real theta = PI * i / 1000.0L;
+        real r = r_range * i / RL(1000.0);
+        real theta = PI * i / RL(1000.0);
         fprintf(stdout, "%.6Lf %.12Lf %.6Lf %.12Lf\n",
-                r, -0.5L * R(r, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val,
-                theta, -0.5L * THETA(theta, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val);
+                (long double)r, (long double)(-RL(0.5) * R(r, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val),
+                (long double)theta, (long double)(-RL(0.5) * THETA(theta, d_dual(k->E), d_dual(k->L), d_dual(k->Q), k->a).val));
     }
     return 0;
 }
@@ -16,8 +16,8 @@ static real RAD_TO_DEG;
 
 point get_current_point (void *data) {
     model *_ = (model *)data;
-    real ra_sth = sqrtl(_->ra2.val) * sinl(_->q_th);
-    return (point){(float)(ra_sth * cosl(_->q_ph)), (float)(ra_sth * sinl(_->q_ph)), (float)(_->q_r * cosl(_->q_th))};
+    real ra_sth = SQRT(_->ra2.val) * SIN(_->q_th);
+    return (point){(float)(ra_sth * COS(_->q_ph)), (float)(ra_sth * SIN(_->q_ph)), (float)(_->q_r * COS(_->q_th))};
 }
 
 void Animate () {
@@ -39,10 +39,10 @@ void Animate () {
         k->tau += k->step_size * S;
         glColor3f(0.0F, 0.5F, 0.5F);
         sprintf(hud, "tau: %.0Lf  t: %.0Lf  r:% 5.1Lf  theta:% 4.0Lf  phi:% 4.0Lf  ",
-                      k->tau, k->q_t, k->q_r, k->q_th * RAD_TO_DEG - 90.0L, fmodl(k->q_ph * RAD_TO_DEG + 180.0L, 360.0L));
+                      (long double)k->tau, (long double)k->q_t, (long double)k->q_r, (long double)(k->q_th * RAD_TO_DEG - RL(90.0)), (long double)(FMOD(k->q_ph * RAD_TO_DEG + RL(180.0), RL(360.0))));
         osd(10, window_height - 20, hud);
         pair speed = gamma_v(k, S);
-        sprintf(hud, "gamma: %.1Lf  v:% .6Lf", speed.a, speed.b);
+        sprintf(hud, "gamma: %.1Lf  v:% .6Lf", (long double)speed.a, (long double)speed.b);
         osd(10, window_height - 40, hud);
         osd_summary();
     }
@@ -62,7 +62,7 @@ int main (int argc, char **argv) {
     since = clock();
     c = symp_get_c(argc, argv);
     k = kerr_get_p(argc, argv, c->h);
-    RAD_TO_DEG = 180.0L / acosl(-1.0L);
+    RAD_TO_DEG = RL(180.0) / ACOS(-RL(1.0));
 
     length = (int)strtol(argv[1], NULL, BASE); CHECK(length >= 0 && length <= c->steps);
     t = malloc(sizeof (trail)); CHECK(t);
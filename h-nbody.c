@@ -10,27 +10,31 @@
 model *get_p_nbody (int argc, char **argv) {
     CHECK((argc - 6) % 7 == 0);
     model *_ = malloc(sizeof (model)); CHECK(_);
-    _->G = strtold(argv[5], NULL); CHECK(_->G > 0.0L);
+    _->G = STRTOR(argv[5], NULL); CHECK(_->G > RL(0.0));
     _->n = (argc - 6) / 7;
     _->bodies = malloc((size_t)_->n * sizeof (body)); CHECK(_->bodies);
     for (int i = 0; i < _->n; i++) {
-        _->bodies[i].m = strtold(argv[7 * i + 6], NULL); CHECK(_->bodies[i].m > 0.0L);
-        _->bodies[i].r = (float)powl(_->bodies[i].m, 1.0L / 3.0L);
-        _->bodies[i].x = strtold(argv[7 * i + 7], NULL);
-        _->bodies[i].y = strtold(argv[7 * i + 8], NULL);
-        _->bodies[i].z = strtold(argv[7 * i + 9], NULL);
-        _->bodies[i].px = strtold(argv[7 * i + 10], NULL);
-        _->bodies[i].py = strtold(argv[7 * i + 11], NULL);
-        _->bodies[i].pz = strtold(argv[7 * i + 12], NULL);
+        _->bodies[i].m = STRTOR(argv[7 * i + 6], NULL); CHECK(_->bodies[i].m > RL(0.0));
+        _->bodies[i].r = (float)POW(_->bodies[i].m, RL(1.0) / RL(3.0));
+        _->bodies[i].x = STRTOR(argv[7 * i + 7], NULL);
+        _->bodies[i].y = STRTOR(argv[7 * i + 8], NULL);
+        _->bodies[i].z = STRTOR(argv[7 * i + 9], NULL);
+        _->bodies[i].px = STRTOR(argv[7 * i + 10], NULL);
+        _->bodies[i].py = STRTOR(argv[7 * i + 11], NULL);
+        _->bodies[i].pz = STRTOR(argv[7 * i + 12], NULL);
     }
     reset_cog(_);
     _->h0 = H(_);
     return _;
 }
 
+block symp_state (model *p) {
+    return (block){p->bodies, (size_t)p->n * sizeof (body)};
+}
+
 void reset_cog (model *p) {
     body *b = p->bodies;
-    real X = 0.0L, Y = 0.0L, Z = 0.0L, M = 0.0L;
+    real X = RL(0.0), Y = RL(0.0), Z = RL(0.0), M = RL(0.0);
     for (int i = 0; i < p->n; i++) {
         X += b[i].x * b[i].m;
         Y += b[i].y * b[i].m;
@@ -45,14 +49,14 @@ void reset_cog (model *p) {
 }
 
 static real distance (real x, real y, real z, real X, real Y, real Z) {
-    return sqrtl(SQR(x - X) + SQR(y - Y) + SQR(z - Z));
+    return SQRT(SQR(x - X) + SQR(y - Y) + SQR(z - Z));
 }
 
 real H (model *p) {
     body *b = p->bodies;
-    real e = 0.0L;
+    real e = RL(0.0);
     for (int i = 0; i < p->n; i++) {
-        e += 0.5L * (SQR(b[i].px) + SQR(b[i].py) + SQR(b[i].pz)) / b[i].m;
+        e += RL(0.5) * (SQR(b[i].px) + SQR(b[i].py) + SQR(b[i].pz)) / b[i].m;
         for (int j = 0; j < i; j++) {
             e -= p->G * b[i].m * b[j].m / distance(b[i].x, b[i].y, b[i].z, b[j].x, b[j].y, b[j].z);
         }
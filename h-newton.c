@@ -10,7 +10,7 @@
 #include "dual.h"
 
 static dual H (real GM, real m, dual r, dual p_r, dual p_phi) {
-    return d_sub(d_scale(d_add(d_sqr(p_r), d_sqr(d_div(p_phi, r))), 0.5L / m), d_scale(d_rec(r), GM * m));
+    return d_sub(d_scale(d_add(d_sqr(p_r), d_sqr(d_div(p_phi, r))), RL(0.5) / m), d_scale(d_rec(r), GM * m));
 }
 
 struct Parameters {
@@ -20,15 +20,19 @@ struct Parameters {
 model *symp_init_p (int argc, char **argv) { (void)argc;
     CHECK(argc == 9);
     model *_ = malloc(sizeof (model)); CHECK(_);
-    _->GM = strtold(argv[5], NULL);
-    _->m = strtold(argv[6], NULL);
-    _->r = strtold(argv[7], NULL);
-    _->phi = _->p_r = 0.0L;
-    _->p_phi = strtold(argv[8], NULL) * _->m * sqrtl(_->GM * _->r); // arg 8 = 1.0 gives a circular orbit
+    _->GM = STRTOR(argv[5], NULL);
+    _->m = STRTOR(argv[6], NULL);
+    _->r = STRTOR(argv[7], NULL);
+    _->phi = _->p_r = RL(0.0);
+    _->p_phi = STRTOR(argv[8], NULL) * _->m * SQRT(_->GM * _->r); // arg 8 = 1.0 gives a circular orbit
     _->h0 = H(_->GM, _->m, d_dual(_->r), d_dual(_->p_r), d_dual(_->p_phi)).val;
     return _;
 }
 
+block symp_state (model *_) {
+    return (block){_, sizeof (model)};
+}
+
 void update_q (model *_, real c) {
     _->r   += c * H(_->GM, _->m, d_dual(_->r),  d_var(_->p_r), d_dual(_->p_phi)).dot;
     _->phi += c * H(_->GM, _->m, d_dual(_->r), d_dual(_->p_r),  d_var(_->p_phi)).dot;
@@ -38,13 +42,24 @@ void update_p (model *_, real d) {
     _->p_r -= d * H(_->GM, _->m, d_var(_->r), d_dual(_->p_r), d_dual(_->p_phi)).dot;
 }
 
-static void plot (int dp, model *_, real t) {
+static void plot (const controls *c, model *_, real t) {
+    if (!out_due(c)) return;
     real h = H(_->GM, _->m, d_dual(_->r), d_dual(_->p_r), d_dual(_->p_phi)).val;
-    printf("% .*Le % .*Le % .*Le % .*Le %.6Le % .*Le % .*Le\n",
-           dp, _->r * sinl(_->phi), dp, _->r * cosl(_->phi), dp, _->r, dp, _->p_r, t, dp, error(h - _->h0), dp, h);
+    real r[] = {_->r * SIN(_->phi), _->r * COS(_->phi), _->r, _->p_r, t, error(h - _->h0), h};
+    if (c->binary) {
+        out_record(r, 7);
+        return;
+    }
+    int dp = c->dp;
+    char s[7][OUT_REAL];
+    for (int i = 0; i < 7; i++) out_real(s[i], " ", dp, r[i]);
+    printf("%s %s %s %s %.6Le %s %s\n", s[0], s[1], s[2], s[3], (long double)r[4], s[5], s[6]);
 }
 
 int main (int argc, char **argv) {
-    solve(symp_get_c(argc, argv), symp_init_p(argc, argv), plot);
+    controls *c = symp_get_c(argc, argv);
+    ckpt_init(argc, argv);
+    out_header(c, argc, argv, "x y r p_r t error H");
+    solve(c, symp_init_p(argc, argv), plot);
     return 0;
 }
@@ -0,0 +1,43 @@
+/*
+ * Hot path instrumentation (make INSTRUMENT=on), call and inner loop counts and phase times, summarised on stderr at
+ * exit; each instrumented file has its own enum of probes and table _probes_, and without INSTRUMENT the macros vanish.
+ * The table is shared by all threads, so the probes add atomically (relaxed, the totals are only read at exit).
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#pragma once
+
+#ifdef INSTRUMENT
+#include <stdio.h>
+#include <time.h>
+
+typedef struct Probe {
+    const char *name;
+    unsigned long long calls, loops, ns;
+} probe;
+
+static inline unsigned long long probe_ns (void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (unsigned long long)t.tv_sec * 1000000000ULL + (unsigned long long)t.tv_nsec;
+}
+
+static inline void probe_report (const probe *p, int n) {
+    fprintf(stderr, "%-14s %14s %16s %12s %12s\n", "probe", "calls", "loops", "seconds", "ns/call");
+    for (int i = 0; i < n; i++) {
+        if (!p[i].calls) continue;
+        if (p[i].ns) {
+            fprintf(stderr, "%-14s %14llu %16s %12.6f %12.1f\n", p[i].name, p[i].calls, "-", (double)p[i].ns / (double)1000000000ULL, (double)p[i].ns / (double)p[i].calls);
+        } else {
+            fprintf(stderr, "%-14s %14llu %16llu %12s %12s\n", p[i].name, p[i].calls, p[i].loops, "-", "-");
+        }
+    }
+}
+
+#define PROBE_ADD(a, n) __atomic_fetch_add(&(a), (unsigned long long)(n), __ATOMIC_RELAXED)
+#define COUNT(i, n) do { PROBE_ADD(_probes_[i].calls, 1); PROBE_ADD(_probes_[i].loops, n); } while (0)
+#define TIME(i, x) do { unsigned long long t0_ = probe_ns(); x; PROBE_ADD(_probes_[i].calls, 1); PROBE_ADD(_probes_[i].ns, probe_ns() - t0_); } while (0)
+#else
+#define COUNT(i, n) do {} while (0)
+#define TIME(i, x) do { x; } while (0)
+#endif
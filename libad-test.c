@@ -5,6 +5,7 @@
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <math.h>
 #include "taylor-ode.h"
 #include "dual.h"
@@ -13,16 +14,16 @@ static int k_max = 0, dp, n, debug = 0, total = 0, passed = 0, skipped = 0;
 
 static real delta, delta_max, tolerance;
 
-real D0 = 0.0L;
-real D01 = 0.1L;
-real D05 = 0.5L;
-real D_05 = -0.5L;
-real D1 = 1.0L;
-real D2 = 2.0L;
-real D3 = 3.0L;
-real D_1 = -1.0L;
-real D_2 = -2.0L;
-real D_3 = -3.0L;
+real D0 = RL(0.0);
+real D01 = RL(0.1);
+real D05 = RL(0.5);
+real D_05 = -RL(0.5);
+real D1 = RL(1.0);
+real D2 = RL(2.0);
+real D3 = RL(3.0);
+real D_1 = -RL(1.0);
+real D_2 = -RL(2.0);
+real D_3 = -RL(3.0);
 
 static char *name_max = "N/A";
 
@@ -70,6 +71,46 @@ triplet ode (series x, series y, series z, const model *p, int k) {
     };
 }
 
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *p, const int k) { (void)x; (void)y; (void)z;
+    return (triplet) {
+        .x = p->a * dx[k],
+        .y = p->b * dy[k],
+        .z = p->c * dz[k]
+    };
+}
+
+triplet ode_p (series x, series y, series z, const model *p, const int i, const int k) { (void)x; (void)y; (void)z; (void)p; (void)i; (void)k;
+    return (triplet) {0};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *p, const int k) {
+    for (int m = 0; m < e->n; m++) {
+        vx[m] = p->a * e->x[k * e->n + m];
+        vy[m] = p->b * e->y[k * e->n + m];
+        vz[m] = p->c * e->z[k * e->n + m];
+    }
+}
+
+static series ad_lane (series l, series e, int m) { for (int k = 0; k < n; k++) l[k] = e[2 * k + m]; return l; }
+
+static series ad_mul_e (series p, series u, series v) {
+    for (int k = 0; k < n; k++) { p[2 * k] = p[2 * k + 1] = RL(0.0); e_mul(p + 2 * k, D1, u, v, k, 2); } return p;
+}
+
+static series ad_sqr_e (series s, series u) {
+    for (int k = 0; k < n; k++) { s[2 * k] = s[2 * k + 1] = RL(0.0); e_sqr(s + 2 * k, D1, u, k, 2); } return s;
+}
+
+static series ad_abs_e (series a, series u) {
+    for (int k = 0; k < n; k++) { a[2 * k] = a[2 * k + 1] = RL(0.0); e_abs(a + 2 * k, D1, u, k, 2); } return a;
+}
+
+static series ad_exp_e (series e, series u) { for (int k = 0; k < n; k++) e_exp(e, u, k, 2); return e; }
+
+static void ad_sin_cos_e (series s, series c, series u, bool trig) { for (int k = 0; k < n; k++) e_sin_cos(s, c, u, k, 2, trig); }
+
+static void ad_tan_sec2_e (series t, series s2, series u, bool trig) { for (int k = 0; k < n; k++) e_tan_sec2(t, s2, u, k, 2, trig); }
+
 static void skip (char* name) {
     total++;
     skipped++;
@@ -79,7 +120,7 @@ static void skip (char* name) {
 static void compare (char* name, series a, series b) {
     total++;
     for (int k = 0; k < n; k++) {
-        delta = fabsl(a[k] - b[k]);
+        delta = FABS(a[k] - b[k]);
         if (delta > delta_max) {
             delta_max = delta;
             name_max = name;
@@ -91,7 +132,7 @@ static void compare (char* name, series a, series b) {
         }
         if (debug == 2) {
             if (!k) fprintf(stderr, "\n");
-            fprintf(stderr, "  %2d  %s% .*Le % .*Le%s  %.1Le\n", k, GRY, dp, a[k], dp, b[k], NRM, delta);
+            fprintf(stderr, "  %2d  %s% .*Le % .*Le%s  %.1Le\n", k, GRY, dp, (long double)a[k], dp, (long double)b[k], NRM, (long double)delta);
         }
     }
     if (debug) fprintf(stderr, "%s PASS%s %s\n", GRN, NRM, name);
@@ -113,40 +154,82 @@ int main (int argc, char **argv) {
     n = (int)strtol(argv[2], NULL, BASE); CHECK(n > 0 && n <=64);
     series u = tsm_jet(n + 1);
     for (int k = 0, s = 1; k <= n; k++, s *= -1) {
-        u[k] = !k ? strtold(argv[3], NULL) : 0.5L * s / SQR(k);
+        u[k] = !k ? STRTOR(argv[3], NULL) : RL(0.5) * s / SQR(k);
     }
     dual ud = {.val = u[0], .dot = u[1]};
-    tolerance = strtold(argv[4], NULL); CHECK(tolerance > 0.0L);
+    tolerance = STRTOR(argv[4], NULL); CHECK(tolerance > RL(0.0));
     if (argc == 6) {
         debug = (int)strtol(argv[5], NULL, BASE); CHECK(debug == 0 || debug == 1 || debug == 2);
     }
 
     fprintf(stderr, "%sHorner Summation ", GRY);
     series s = tsm_jet(8);
-    s[0] = 1.0L; s[1] = 3.0L; s[2] = 0.0L; s[3] = 2.0L;
-    CHECK(horner(s, 3, 2.0L) == 23.0L); fprintf(stderr, ".");
-    s[0] = 3.0L; s[1] = -1.0L; s[2] = 2.0L; s[3] = -4.0L; s[4] = 0.0L; s[5] = 1.0L;
-    CHECK(horner(s, 5, 3.0L) == 153.0L); fprintf(stderr, ".");
-    s[0] = 1.0L; s[1] = -4.0L; s[2] = 0.0L; s[3] = 0.0L; s[4] = 2.0L; s[5] = 3.0L; s[6] = 0.0L; s[7] = -2.0L;
-    CHECK(horner(s, 7, -2.0L) == 201.0L); fprintf(stderr, ".%s OK%s", NRM, GRY);
+    s[0] = RL(1.0); s[1] = RL(3.0); s[2] = RL(0.0); s[3] = RL(2.0);
+    CHECK(horner(s, 3, RL(2.0)) == RL(23.0)); fprintf(stderr, ".");
+    s[0] = RL(3.0); s[1] = -RL(1.0); s[2] = RL(2.0); s[3] = -RL(4.0); s[4] = RL(0.0); s[5] = RL(1.0);
+    CHECK(horner(s, 5, RL(3.0)) == RL(153.0)); fprintf(stderr, ".");
+    s[0] = RL(1.0); s[1] = -RL(4.0); s[2] = RL(0.0); s[3] = RL(0.0); s[4] = RL(2.0); s[5] = RL(3.0); s[6] = RL(0.0); s[7] = -RL(2.0);
+    CHECK(horner(s, 7, -RL(2.0)) == RL(201.0)); fprintf(stderr, ".%s OK%s", NRM, GRY);
+
+    fprintf(stderr, ", Jet Arena ");
+    arena a = tsm_arena(sizeof (xyz), 3, n + 1);
+    xyz *_ = tsm_take(&a, sizeof (xyz));
+    _->x = tsm_arena_jet(&a, n + 1); _->x[0] = RL(1.0);
+    _->y = tsm_arena_jet(&a, n + 1); _->y[0] = RL(1.0);
+    _->z = tsm_arena_jet(&a, n + 1); _->z[0] = RL(1.0);
+    CHECK(!((uintptr_t)_ % 64) && !((uintptr_t)_->x % 64)); fprintf(stderr, ".");
+    CHECK((void *)_ < (void *)_->x && _->x < _->y && _->y < _->z && _->y - _->x == _->z - _->y); fprintf(stderr, ".");
+    CHECK(_->z[n] == RL(0.0) && a.next == a.end); fprintf(stderr, ".%s OK%s", NRM, GRY);
 
     fprintf(stderr, ", Taylor Series Method ");
-    controls c = {.order=n, .step=0, .steps=10, .h=0.1L};
-    model p = {.a=1.0L, .b=0.0L, .c=-1.0L};
-    xyz *_ = malloc(sizeof (xyz)); CHECK(_);
-    _->x = tsm_jet(n + 1); _->x[0] = 1.0L;
-    _->y = tsm_jet(n + 1); _->y[0] = 1.0L;
-    _->z = tsm_jet(n + 1); _->z[0] = 1.0L;
+    controls c = {.order=n, .step=0, .steps=10, .h=RL(0.1)};
+    model p = {.a=RL(1.0), .b=RL(0.0), .c=-RL(1.0)};
     while (tsm_gen(&c, _, &p)) fprintf(stderr, ".");
-    CHECK(fabsl(_->x[0] - expl(p.a)) < tolerance);
-    CHECK(fabsl(_->y[0] - expl(p.b)) < tolerance);
-    CHECK(fabsl(_->z[0] - expl(p.c)) < tolerance);
+    CHECK(FABS(_->x[0] - EXP(p.a)) < tolerance);
+    CHECK(FABS(_->y[0] - EXP(p.b)) < tolerance);
+    CHECK(FABS(_->z[0] - EXP(p.c)) < tolerance);
+    fprintf(stderr, "%s OK%s", NRM, GRY);
+
+    fprintf(stderr, ", Variable Step TSM ");
+    c.tol = RL(1.0e-3) * tolerance;
+    _->x[0] = _->y[0] = _->z[0] = RL(1.0);
+    while (tsm_gen(&c, _, &p)) fprintf(stderr, ".");
+    CHECK(c.t > RL(0.0));
+    CHECK(FABS(_->x[0] - EXP(p.a * c.t)) < tolerance * EXP(p.a * c.t));
+    CHECK(FABS(_->y[0] - EXP(p.b * c.t)) < tolerance);
+    CHECK(FABS(_->z[0] - EXP(p.c * c.t)) < tolerance);
+    c.tol = RL(0.0);
+    fprintf(stderr, "%s OK%s", NRM, GRY);
+
+    fprintf(stderr, ", Ensemble TSM ");
+    c.step = 0;
+    ensemble *e = malloc(sizeof (ensemble)); CHECK(e);
+    e->n = 2;
+    e->x = tsm_jet(2 * (n + 1)); e->x[0] = RL(1.0); e->x[1] = RL(2.0); e->vx = tsm_jet(2);
+    e->y = tsm_jet(2 * (n + 1)); e->y[0] = RL(1.0); e->y[1] = RL(2.0); e->vy = tsm_jet(2);
+    e->z = tsm_jet(2 * (n + 1)); e->z[0] = RL(1.0); e->z[1] = RL(2.0); e->vz = tsm_jet(2);
+    while (ens_gen(&c, e, &p)) fprintf(stderr, ".");
+    for (int m = 0; m < 2; m++) {
+        CHECK(FABS(e->x[m] - (m + 1) * EXP(p.a)) < tolerance);
+        CHECK(FABS(e->y[m] - (m + 1) * EXP(p.b)) < tolerance);
+        CHECK(FABS(e->z[m] - (m + 1) * EXP(p.c)) < tolerance);
+    }
+    fprintf(stderr, "%s OK%s", NRM, GRY);
+
+    fprintf(stderr, ", Lyapunov Spectrum ");
+    c.step = 0;
+    _->x[0] = _->y[0] = _->z[0] = RL(1.0);
+    tangents *t = lyap_init(n);
+    while (lyap_gen(&c, _, t, &p)) fprintf(stderr, ".");
+    CHECK(FABS(t->sum[0] / c.t - p.a) < tolerance);
+    CHECK(FABS(t->sum[1] / c.t - p.b) < tolerance);
+    CHECK(FABS(t->sum[2] / c.t - p.c) < tolerance);
     fprintf(stderr, "%s OK\n", NRM);
 
-    fprintf(stderr, "Taylor Arithmetic %su = %s%.1Lf%s\n", GRY, WHT, u[0], NRM);
-    bool positive = u[0] > 0.0L, non_zero = u[0] != 0.0L, lt_1 = fabsl(u[0]) < 1.0L, gt_1 = u[0] > 1.0L,
-         lt_pi_2 = fabsl(u[0]) < 0.5L * acosl(-1.0L);
-    series r1 = tsm_jet(n), r2 = tsm_jet(n), r3 = tsm_jet(n), S1 = tsm_jet(n); S1[0] = 1.0L;
+    fprintf(stderr, "Taylor Arithmetic %su = %s%.1Lf%s\n", GRY, WHT, (long double)u[0], NRM);
+    bool positive = u[0] > RL(0.0), non_zero = u[0] != RL(0.0), lt_1 = FABS(u[0]) < RL(1.0), gt_1 = u[0] > RL(1.0),
+         lt_pi_2 = FABS(u[0]) < RL(0.5) * ACOS(-RL(1.0));
+    series r1 = tsm_jet(n), r2 = tsm_jet(n), r3 = tsm_jet(n), S1 = tsm_jet(n); S1[0] = RL(1.0);
     series abs_u = tsm_jet(n), rec_u = tsm_jet(n), sqrt_u = tsm_jet(n), ln_u = tsm_jet(n);
     if (non_zero) ad_abs(abs_u, u);
     if (non_zero) ad_rec(rec_u, u);
@@ -198,7 +281,7 @@ int main (int argc, char **argv) {
     name = "acosh(u)"; if (gt_1) {ad_acos_sin(acosh_u, r2, u, false); compare_s_d(name, acosh_u, d_acosh(ud));} else skip(name);
     name = "atanh(u)"; if (lt_1) {ad_atan_sec2(atanh_u, r2, u, false); compare_s_d(name, atanh_u, d_atanh(ud));}  else skip(name);
 
-    name = "u^1.5"; positive ? compare_s_d(name, ad_pwr(r1, u, 1.5L), d_pow(ud, 1.5L)) : skip(name);
+    name = "u^1.5"; positive ? compare_s_d(name, ad_pwr(r1, u, RL(1.5)), d_pow(ud, RL(1.5))) : skip(name);
 
     if (debug) fprintf(stderr, "\n");
 
@@ -278,11 +361,27 @@ int main (int argc, char **argv) {
     name = "arcsin(tanh(gd^-1 u)) == u"; if (lt_pi_2) {ad_tan_sec2(r3, r2, gd_1, false); ad_asin_cos(r1, r2, r3, true); compare(name, r1, u);} else skip(name);
     name = "arctan(sinh(gd^-1 u)) == u"; if (lt_pi_2) {ad_sin_cos(r3, r2, gd_1, false); ad_atan_sec2(r1, r2, r3, true); compare(name, r1, u);} else skip(name);
 
+    if (debug) fprintf(stderr, "\n");
+
+    series ue = tsm_jet(2 * n), re = tsm_jet(2 * n), se = tsm_jet(2 * n), ce = tsm_jet(2 * n);
+    for (int k = 0; k < n; k++) { ue[2 * k] = RL(2.0) * u[k]; ue[2 * k + 1] = u[k]; }  // lanes are 2u and u
+
+    name = "e_mul(u, u) == sqr(u)"; compare(name, ad_lane(r1, ad_mul_e(re, ue, ue), 1), sqr_u);
+    name = "e_sqr(u) == sqr(u)"; compare(name, ad_lane(r1, ad_sqr_e(re, ue), 1), sqr_u);
+    name = "e_abs(u) == |u|"; non_zero ? compare(name, ad_lane(r1, ad_abs_e(re, ue), 1), abs_u) : skip(name);
+    name = "e_exp(u) == exp(u)"; compare(name, ad_lane(r1, ad_exp_e(re, ue), 1), exp_u);
+    ad_sin_cos_e(se, ce, ue, true);
+    name = "e_sin(2u) == sin(2u)"; compare(name, ad_lane(r1, se, 0), sin_2u);
+    name = "e_cos(2u) == cos(2u)"; compare(name, ad_lane(r1, ce, 0), cos_2u);
+    ad_tan_sec2_e(se, ce, ue, false);
+    name = "e_tanh(u) == tanh(u)"; compare(name, ad_lane(r1, se, 1), tanh_u);
+    name = "e_sech2(u) == sech2(u)"; compare(name, ad_lane(r1, ce, 1), sech2_u);
+
     if (debug) fprintf(stderr, "\n");
     fprintf(stderr, "%sTotal%s %d  %sPASSED%s %d", WHT, NRM, total, GRN, NRM, passed);
     if (skipped) fprintf(stderr, "  %sSKIPPED%s %d", YLW, NRM, skipped);
     if (passed == total - skipped) {
-        fprintf(stderr, "\n%sDelta%s %.1Le %s%s%s %sk == %d%s\n", GRY, NRM, delta_max, BLU, name_max, NRM, GRY, k_max, NRM);
+        fprintf(stderr, "\n%sDelta%s %.1Le %s%s%s %sk == %d%s\n", GRY, NRM, (long double)delta_max, BLU, name_max, NRM, GRY, k_max, NRM);
         return 0;
     } else {
         fprintf(stderr, "  %sFAILED%s %d\n\n", RED, NRM, total - passed - skipped);
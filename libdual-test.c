@@ -19,28 +19,28 @@ static void skip (char* name) {
 }
 
 static void compare (char* name, dual a, dual b) {
-    real delta_max = 0.0L;
+    real delta_max = RL(0.0);
     total++;
-    real delta_val = fabsl(a.val - b.val);
+    real delta_val = FABS(a.val - b.val);
     if (delta_val > delta_max) {
         delta_max = delta_val;
     }
     if (debug == 2) {
         if (delta_val > tolerance) {
-            fprintf(stderr, "  %sval  %s% .*Le % .*Le  %s%.1Le%s\n", RED, NRM, dp, a.val, dp, b.val, RED, delta_val, NRM);
+            fprintf(stderr, "  %sval  %s% .*Le % .*Le  %s%.1Le%s\n", RED, NRM, dp, (long double)a.val, dp, (long double)b.val, RED, (long double)delta_val, NRM);
         } else {
-            fprintf(stderr, "  val  %s% .*Le % .*Le%s  %.1Le\n", GRY, dp, a.val, dp, b.val, NRM, delta_val);
+            fprintf(stderr, "  val  %s% .*Le % .*Le%s  %.1Le\n", GRY, dp, (long double)a.val, dp, (long double)b.val, NRM, (long double)delta_val);
         }
     }
-    real delta_dot = fabsl(a.dot - b.dot);
+    real delta_dot = FABS(a.dot - b.dot);
     if (delta_dot > delta_max) {
         delta_max = delta_dot;
     }
     if (debug == 2) {
         if (delta_dot > tolerance) {
-            fprintf(stderr, "  %sdot  %s% .*Le % .*Le%s  %.1Le%s\n", RED, NRM, dp, a.dot, dp, b.dot, RED, delta_dot, NRM);
+            fprintf(stderr, "  %sdot  %s% .*Le % .*Le%s  %.1Le%s\n", RED, NRM, dp, (long double)a.dot, dp, (long double)b.dot, RED, (long double)delta_dot, NRM);
         } else {
-            fprintf(stderr, "  dot  %s% .*Le % .*Le%s  %.1Le\n", GRY, dp, a.dot, dp, b.dot, NRM, delta_dot);
+            fprintf(stderr, "  dot  %s% .*Le % .*Le%s  %.1Le\n", GRY, dp, (long double)a.dot, dp, (long double)b.dot, NRM, (long double)delta_dot);
         }
     }
     bool failed = delta_max > tolerance;
@@ -60,15 +60,15 @@ int main (int argc, char **argv) {
     CHECK(argc == 4 || argc == 5);
 
     dp = (int)strtol(argv[1], NULL, BASE);
-    dual u = (dual){.val = strtold(argv[2], NULL), .dot = 0.5L};
-    tolerance = strtold(argv[3], NULL); CHECK(tolerance > 0.0L);
+    dual u = (dual){.val = STRTOR(argv[2], NULL), .dot = RL(0.5)};
+    tolerance = STRTOR(argv[3], NULL); CHECK(tolerance > RL(0.0));
     if (argc == 5) {
         debug = (int)strtol(argv[4], NULL, BASE); CHECK(debug == 0 || debug == 1 || debug == 2);
     }
 
-    fprintf(stderr, "Dual Numbers %su = %s%.1Lf%s\n", GRY, WHT, u.val, NRM);
-    bool positive = u.val > 0.0L, non_zero = u.val != 0.0L, lt_pi_2 = fabsl(u.val) < 0.5L * acosl(-1.0L);
-    dual D1 = d_dual(1.0L), upu = d_scale(u, 2.0L);
+    fprintf(stderr, "Dual Numbers %su = %s%.1Lf%s\n", GRY, WHT, (long double)u.val, NRM);
+    bool positive = u.val > RL(0.0), non_zero = u.val != RL(0.0), lt_pi_2 = FABS(u.val) < RL(0.5) * ACOS(-RL(1.0));
+    dual D1 = d_dual(RL(1.0)), upu = d_scale(u, RL(2.0));
     dual abs_u, inv_u, sqrt_u, ln_u;
     if (non_zero) abs_u = d_abs(u);
     if (positive || non_zero) inv_u = d_rec(u);
@@ -78,7 +78,7 @@ int main (int argc, char **argv) {
     dual sin2_u = d_sqr(sin_u), cos2_u = d_sqr(cos_u), sin_2u = d_sin(upu), cos_2u = d_cos(upu);
     dual sinh_u = d_sinh(u), cosh_u = d_cosh(u), tanh_u = d_tanh(u);
     dual sinh2_u = d_sqr(sinh_u), cosh2_u = d_sqr(cosh_u), sinh_2u = d_sinh(upu), cosh_2u = d_cosh(upu);
-    dual sqr_u = d_sqr(u), exp_u = d_exp(u), neg_exp_u = d_exp(d_scale(u, -1.0L));
+    dual sqr_u = d_sqr(u), exp_u = d_exp(u), neg_exp_u = d_exp(d_scale(u, -RL(1.0)));
     dual gd_1 = d_ln(d_abs(d_div(d_add(sin_u, D1), cos_u)));
 
     char* name = "u * u == sqr(u)"; compare(name, d_mul(u, u), sqr_u);
@@ -89,39 +89,39 @@ int main (int argc, char **argv) {
 
     if (debug) fprintf(stderr, "\n");
 
-    name = "u^2.0 == sqr(u)"; positive ? compare(name, d_pow(u, 2.0L), sqr_u) : skip(name);
-    name = "u^1.0 == u"; positive ? compare(name, d_pow(u, 1.0L), u) : skip(name);
-    name = "u^0.5 == sqrt(u)"; positive ? compare(name, d_pow(u, 0.5L), sqrt_u): skip(name);
-    name = "u^0.0 == 1"; positive ? compare(name, d_pow(u, 0.0L), D1) : skip(name);
-    name = "u^-0.5 == 1 / sqrt(u)"; positive ? compare(name, d_pow(u, -0.5L), d_rec(sqrt_u)) : skip(name);
-    name = "u^-1.0 == 1 / u"; positive ? compare(name, d_pow(u, -1.0L), inv_u) : skip(name);
-    name = "u^-2.0 == 1 / sqr(u)"; positive ? compare(name, d_pow(u, -2.0L), d_rec(sqr_u)) : skip(name);
+    name = "u^2.0 == sqr(u)"; positive ? compare(name, d_pow(u, RL(2.0)), sqr_u) : skip(name);
+    name = "u^1.0 == u"; positive ? compare(name, d_pow(u, RL(1.0)), u) : skip(name);
+    name = "u^0.5 == sqrt(u)"; positive ? compare(name, d_pow(u, RL(0.5)), sqrt_u): skip(name);
+    name = "u^0.0 == 1"; positive ? compare(name, d_pow(u, RL(0.0)), D1) : skip(name);
+    name = "u^-0.5 == 1 / sqrt(u)"; positive ? compare(name, d_pow(u, -RL(0.5)), d_rec(sqrt_u)) : skip(name);
+    name = "u^-1.0 == 1 / u"; positive ? compare(name, d_pow(u, -RL(1.0)), inv_u) : skip(name);
+    name = "u^-2.0 == 1 / sqr(u)"; positive ? compare(name, d_pow(u, -RL(2.0)), d_rec(sqr_u)) : skip(name);
 
     if (debug) fprintf(stderr, "\n");
 
-    name = "sqr(u) * u^-3 == 1 / u"; positive ? compare(name, d_mul(sqr_u, d_pow(u, -3.0L)), inv_u) : skip(name);
-    name = "sqr(u)^0.5 == |u|"; non_zero ? compare(name, d_pow(sqr_u, 0.5L), abs_u) : skip(name);
+    name = "sqr(u) * u^-3 == 1 / u"; positive ? compare(name, d_mul(sqr_u, d_pow(u, -RL(3.0))), inv_u) : skip(name);
+    name = "sqr(u)^0.5 == |u|"; non_zero ? compare(name, d_pow(sqr_u, RL(0.5)), abs_u) : skip(name);
     name = "sqrt(sqr(u) == |u|"; non_zero ? compare(name, d_sqrt(sqr_u), abs_u) : skip(name);
 
     if (debug) fprintf(stderr, "\n");
 
     name = "ln(e^u) == u"; compare(name, d_ln(d_exp(u)), u);
-    name = "ln(sqr(u)) == ln(u) * 2"; positive ? compare(name, d_ln(sqr_u), d_scale(ln_u, 2.0L)) : skip(name);
-    name = "ln(sqrt(u)) == ln(u) / 2"; positive ? compare(name, d_ln(sqrt_u), d_scale(ln_u, 0.5L)) : skip(name);
-    name = "ln(1 / u) == - ln(u)"; positive ? compare(name, d_ln(inv_u), d_scale(ln_u, -1.0L)) : skip(name);
-    name = "ln(u^-3) == -3*ln(u)"; positive ? compare(name, d_ln(d_pow(u, -3.0L)), d_scale(ln_u, -3.0L)) : skip(name);
+    name = "ln(sqr(u)) == ln(u) * 2"; positive ? compare(name, d_ln(sqr_u), d_scale(ln_u, RL(2.0))) : skip(name);
+    name = "ln(sqrt(u)) == ln(u) / 2"; positive ? compare(name, d_ln(sqrt_u), d_scale(ln_u, RL(0.5))) : skip(name);
+    name = "ln(1 / u) == - ln(u)"; positive ? compare(name, d_ln(inv_u), d_scale(ln_u, -RL(1.0))) : skip(name);
+    name = "ln(u^-3) == -3*ln(u)"; positive ? compare(name, d_ln(d_pow(u, -RL(3.0))), d_scale(ln_u, -RL(3.0))) : skip(name);
 
     if (debug) fprintf(stderr, "\n");
 
     name = "cosh^2(u) == 1 + sinh^2(u)"; compare(name, cosh2_u, d_add(D1, sinh2_u));
     name = "tanh(u) == sinh(u) / cosh(u)"; compare(name, tanh_u, d_div(sinh_u, cosh_u));
-    name = "sinh(2u) == 2 * sinh(u) * cosh(u)"; compare(name, sinh_2u, d_scale(d_mul(sinh_u, cosh_u), 2.0L));
+    name = "sinh(2u) == 2 * sinh(u) * cosh(u)"; compare(name, sinh_2u, d_scale(d_mul(sinh_u, cosh_u), RL(2.0)));
     name = "cosh(2u) == cosh^2(u) + sinh^2(u)"; compare(name, cosh_2u, d_add(cosh2_u, sinh2_u));
 
     if (debug) fprintf(stderr, "\n");
 
-    name = "cosh(u) == (e^u + e^-u) / 2"; compare(name, cosh_u, d_scale(d_add(exp_u, neg_exp_u), 0.5L));
-    name = "sinh(u) == (e^u - e^-u) / 2"; compare(name, sinh_u, d_scale(d_sub(exp_u, neg_exp_u), 0.5L));
+    name = "cosh(u) == (e^u + e^-u) / 2"; compare(name, cosh_u, d_scale(d_add(exp_u, neg_exp_u), RL(0.5)));
+    name = "sinh(u) == (e^u - e^-u) / 2"; compare(name, sinh_u, d_scale(d_sub(exp_u, neg_exp_u), RL(0.5)));
     name = "tanh(u) == (e^u - e^-u) / (e^u + e^-u)"; compare(name, tanh_u, d_div(d_sub(exp_u, neg_exp_u), d_add(exp_u, neg_exp_u)));
 
     if (debug) fprintf(stderr, "\n");
@@ -134,7 +134,7 @@ int main (int argc, char **argv) {
 
     name = "cos^2(u) == 1 - sin^2(u)"; compare(name, cos2_u, d_sub(D1, sin2_u));
     name = "tan(u) == sin(u) / cos(u)"; lt_pi_2 ? compare(name, tan_u, d_div(sin_u, cos_u)) : skip(name);
-    name = "sin(2u) == 2 * sin(u) * cos(u)"; compare(name, sin_2u, d_scale(d_mul(sin_u, cos_u), 2.0L));
+    name = "sin(2u) == 2 * sin(u) * cos(u)"; compare(name, sin_2u, d_scale(d_mul(sin_u, cos_u), RL(2.0)));
     name = "cos(2u) == cos^2(u) - sin^2(u)"; compare(name, cos_2u, d_sub(cos2_u, sin2_u));
 
     if (debug) fprintf(stderr, "\n");
@@ -0,0 +1,62 @@
+/*
+ * Clean Numerical Simulation duration against Taylor Series order, all orders on all cores against one reference
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taylor-ode.h"
+#include "pool.h"
+
+typedef struct CnsScan {
+    int argc, max;
+    char **argv;
+    real threshold;
+    controls *c;
+    triplet *path;
+    pair *clean;
+    bool *valid;
+} cns_scan;
+
+static void work (void *arg, void *worker, int i) { (void)worker;
+    cns_scan *s = arg;
+    int order = s->max - i;  // longest first
+    controls c = *s->c;
+    c.order = order;
+    xyz *jets = tsm_init(s->argv, order);
+    model *p = tsm_init_p(s->argc, s->argv, order);
+    s->valid[order] = tsm_cns_path(&c, jets, p, s->path, &s->threshold, 1, &s->clean[order]) == 1;
+    free(jets);  // one arena each
+    free(p);
+}
+
+int main (int argc, char **argv) {
+    CHECK(argc > 10);
+    cns_scan *s = malloc(sizeof (cns_scan)); CHECK(s);
+    s->max = (int)strtol(argv[1], NULL, BASE); CHECK(s->max >= 2 && s->max <= 32);
+    s->threshold = STRTOR(argv[2], NULL);
+    CHECK(!strcmp(argv[4], "_"));
+    argv[4] = argv[1];  // placeholder order for argument checks
+    argv[2] = argv[0];  // the rest is a normal tsm-*-std command
+    s->argc = argc - 2;
+    s->argv = argv + 2;
+    s->c = tsm_get_c(s->argc, s->argv);
+
+    controls r = *s->c;  // reference, maximum order with half the step size
+    r.h /= RL(2.0);
+    s->path = tsm_path(&r, tsm_init(s->argv, r.order), tsm_init_p(s->argc, s->argv, r.order), 2, s->c->steps);
+    s->clean = malloc((size_t)(s->max + 1) * sizeof (pair)); CHECK(s->clean);
+    s->valid = malloc((size_t)(s->max + 1) * sizeof (bool)); CHECK(s->valid);
+    pool_run(0, s->max - 1, NULL, work, NULL, s);  // orders max down to 2
+
+    for (int order = 2; order <= s->max; order++) {
+        if (s->valid[order]) {
+            printf("%d %.3Lf %.3Lf\n", order, (long double)s->clean[order].a, (long double)s->clean[order].b);
+        } else {
+            printf("%d Still within %.1Le - not chaotic, or simulation time too short\n", order, (long double)s->threshold);
+        }
+    }
+    return 0;
+}
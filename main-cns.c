@@ -0,0 +1,43 @@
+/*
+ * Clean Numerical Simulation, the requested integration and a "better" one side by side in a single process
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taylor-ode.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 10);
+    char *method = argv[1];
+    int n = 1;
+    for (char *s = argv[2]; *s; s++) if (*s == ',') n++;
+    real *threshold = malloc((size_t)n * sizeof (real)); CHECK(threshold);
+    char *s = argv[2];
+    for (int i = 0; i < n; i++, s++) threshold[i] = STRTOR(s, &s);
+
+    argv[2] = argv[0];  // the rest is a normal tsm-*-std command
+    argc -= 2;
+    argv += 2;
+    controls *c = tsm_get_c(argc, argv);
+    controls *r = malloc(sizeof (controls)); CHECK(r);
+    *r = *c;
+    int substeps = 1;
+    if (!strcmp(method, "step2")) {  // half the step size
+        r->h = c->h / RL(2.0);
+        r->steps = 2 * c->steps;
+        substeps = 2;
+    } else if (!strcmp(method, "order2")) {  // double the order
+        r->order = 2 * c->order; CHECK(r->order <= ORDER_MAX);
+    } else {
+        fprintf(stderr, "CNS: Bad Method, should be 'step2' or 'order2'\n");
+        return 1;
+    }
+
+    int exceeded = tsm_cns(c, tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order),
+                           r, tsm_init(argv, r->order), tsm_init_p(argc, argv, r->order), substeps, threshold, n);
+    if (exceeded < n) fprintf(stderr, "%sStill within %s%.1Le%s - not chaotic, or simulation time too short%s\n",
+                              YLW, WHT, (long double)threshold[exceeded], YLW, NRM);
+    return 0;
+}
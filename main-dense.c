@@ -0,0 +1,32 @@
+/*
+ * Dense output, samples on a fixed time grid (or the raw jets) whatever the step size
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 9);
+
+    char *grid = argv[1];
+    argv[1] = argv[0];  // the rest is a normal tsm-*-std command
+    argc--;
+    argv++;
+    controls *c = tsm_get_c(argc, argv);
+    if (!strcmp(grid, "jets")) {
+        char *columns = malloc((size_t)(c->order + 1) * 3 * 8 + 8); CHECK(columns);
+        char *s = columns + sprintf(columns, "t h");
+        for (int i = 0; i < 3; i++) for (int k = 0; k <= c->order; k++) s += sprintf(s, " %c%d", 'x' + i, k);
+        out_header(c, argc, argv, columns);
+        tsm_jets(c, tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order));
+    } else {
+        out_header(c, argc, argv, "x y z t");
+        tsm_dense(c, tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order), STRTOR(grid, NULL), clock());
+    }
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+/*
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 8);
+
+    controls *c = tsm_get_c(argc, argv);
+    out_header(c, argc, argv, "x y z t");
+    ensemble *e = ens_init(argv, c->order);
+    ens_tsm(c, e, tsm_init_p(argc, argv, c->order * e->n), clock());
+
+    return 0;
+}
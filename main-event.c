@@ -0,0 +1,23 @@
+/*
+ * Events (Poincare sections & extrema), located inside the integration steps
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 9);
+
+    event *e = tsm_event(argv[1]);
+    argv[1] = argv[0];  // the rest is a normal tsm-*-std command
+    argc--;
+    argv++;
+    controls *c = tsm_get_c(argc, argv);
+    out_header(c, argc, argv, "x y z t");
+    tsm_events(c, tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order), e, clock());
+
+    return 0;
+}
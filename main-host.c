@@ -0,0 +1,139 @@
+/*
+ * Multi-model TSM (every registered model in one binary), either one run, as tsm-<model>-std but with the model name in
+ * front of the usual parameters, or a job file ("-" for stdin) of many such commands, one to a line, run on all cores
+ * without starting a process for each; jobs report their final state, in job file order
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "taylor-ode.h"
+#include "output.h"
+#include "registry.h"
+#include "pool.h"
+
+typedef struct Job {
+    int line, argc;
+    char **argv;
+    controls *c;
+    triplet end;
+    real t, cpu;
+} job;
+
+typedef struct Jobs {
+    int n;
+    job *j;
+} jobs;
+
+static void work (void *arg, void *worker, int n) { (void)worker;
+    job *j = &((jobs *)arg)->j[n];
+    real cpu = tsm_thread_cpu();
+    xyz *jets = tsm_init(j->argv, j->c->order);
+    model *p = tsm_init_p(j->argc, j->argv, j->c->order);
+    while (tsm_gen(j->c, jets, p));
+    j->end = (triplet){jets->x[0], jets->y[0], jets->z[0]};
+    j->t = j->c->t;
+    j->cpu = tsm_thread_cpu() - cpu;
+    free(jets);  // one arena each
+    free(p);
+}
+
+static bool numeric (const char *word, bool integer) {  // the whole word converts
+    char *end;
+    if (integer) {
+        (void)strtol(word, &end, BASE);
+    } else {
+        (void)STRTOR(word, &end);
+    }
+    return end != word && !*end;
+}
+
+static const char *invalid (int argc, char **argv) {  // why a job can not run, as tsm_read_c() & tsm_init_p() would abort
+    if (!tsm_hosted(argv[0])) return "unknown model";
+    if (argc != 8 + tsm_parameters(argv[0])) return "wrong number of arguments";
+    char *end;
+    long dp = strtol(argv[1], &end, BASE);
+    if (end == argv[1] || dp < 0 || (*end && (*end != ':' || !numeric(end + 1, true) || strtol(end + 1, NULL, BASE) < 1))) {
+        return "output is <dp>[:<stride>], text only";
+    }
+    for (int i = 2; i < argc; i++) if (!numeric(argv[i], i == 2 || i == 4)) return "not a number";
+    real h = STRTOR(argv[3], NULL);
+    if (h == RL(0.0) || h <= RL(-1.0)) return "step size zero, or tolerance not below 1";
+    long order = strtol(argv[2], NULL, BASE);
+    if (!order && h < RL(0.0)) order = (long)CEIL(RL(1.0) - RL(0.5) * LOG(- h));  // as tsm_read_c()
+    if (order < 2 || order > ORDER_MAX) return "order out of range";
+    if (strtol(argv[4], NULL, BASE) < 0) return "negative steps";
+    return NULL;
+}
+
+static jobs *read_jobs (const char *file) {  // every line is checked before anything is run
+    FILE *f = strcmp(file, "-") ? fopen(file, "r") : stdin; CHECK(f);
+    jobs *s = malloc(sizeof (jobs)); CHECK(s);
+    int size = 64;
+    s->n = 0;
+    s->j = malloc((size_t)size * sizeof (job)); CHECK(s->j);
+    char *line = NULL;
+    size_t room = 0;
+    for (int number = 1; getline(&line, &room, f) != -1; number++) {
+        char *text = strdup(line); CHECK(text);
+        char **argv = malloc((strlen(text) / 2 + 2) * sizeof (char *)); CHECK(argv);
+        int argc = 0;
+        for (char *word = strtok(text, " \t\n"); word; word = strtok(NULL, " \t\n")) argv[argc++] = word;
+        if (!argc || argv[0][0] == '#') {
+            free(argv);
+            free(text);
+            continue;
+        }
+        argv[argc] = NULL;
+        const char *why = invalid(argc, argv);
+        if (why) {
+            fprintf(stderr, "%sjob file line %s%d%s, %s: %s%s", RED, WHT, number, RED, why, NRM, line);
+            exit(1);
+        }
+        if (s->n == size) {
+            size *= 2;
+            s->j = realloc(s->j, (size_t)size * sizeof (job)); CHECK(s->j);
+        }
+        controls *c = tsm_read_c(argv);
+        s->j[s->n++] = (job){.line = number, .argc = argc, .argv = argv, .c = c};
+    }
+    free(line);
+    if (f != stdin) fclose(f);
+    return s;
+}
+
+int main (int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "%smodels%s", GRY, CYN);
+        for (int i = 0; tsm_model(i); i++) fprintf(stderr, " %s", tsm_model(i));
+        fprintf(stderr, "%s\n", NRM);
+    }
+    CHECK(argc >= 2);
+
+    if (argc > 2) {  // one run, as tsm-<model>-std
+        argc--;
+        argv++;
+        CHECK(tsm_hosted(argv[0]) && argc == 8 + tsm_parameters(argv[0]));
+        controls *c = tsm_get_c(argc, argv);
+        ckpt_init(argc, argv);
+        out_header(c, argc, argv, "x y z t");
+        tsm(c, tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order), clock());
+        return 0;
+    }
+
+    jobs *s = read_jobs(argv[1]);
+    int threads = pool_run(0, s->n, NULL, work, NULL, s);
+
+    for (int n = 0; n < s->n; n++) {
+        const job *j = &s->j[n];
+        int dp = j->c->dp;
+        char x[OUT_REAL], y[OUT_REAL], z[OUT_REAL];
+        printf("%d %s %s %s %s %.6Le %.3Lf\n", j->line, j->argv[0], out_real(x, "+", dp, j->end.x), out_real(y, "+", dp, j->end.y),
+               out_real(z, "+", dp, j->end.z), (long double)j->t, (long double)j->cpu);
+    }
+    fprintf(stderr, "%s%d%s jobs, %s%d%s threads\n", WHT, s->n, GRY, WHT, threads, NRM);
+    return 0;
+}
@@ -16,21 +16,32 @@ static real v2 (real vt, real vr, real vth, real vph, real a, real ra2, real sth
     return SQR(va) * sth2 / S + SQR(vr) / D / S + SQR(vth) / S -  SQR(vb) * D / S;
 }
 
-static void plot (int dp, model *p, real mino) {
+static void plot (const controls *c, model *p, real mino) {
     real S = sigma(p);
+    p->tau += p->step_size * S;  // proper time accumulates at every step
+    if (!out_due(c)) return;
     pair Y = gamma_v(p, S);
-    p->tau += p->step_size * S;
-    real ra_sth = sqrtl(p->ra2.val) * sinl(p->q_th);
-    printf("% .*Le % .*Le % .*Le  %.6Le % .*Le % .*Le % .*Le  % .*Le % .*Le  %.6Le %.6Le\n",
-           dp, ra_sth * cosl(p->q_ph), dp, ra_sth * sinl(p->q_ph), dp, p->q_r * cosl(p->q_th), mino,
-           dp, error(1.0L + v2(p->v_t, p->v_r, p->v_th, p->v_ph, p->a, p->ra2.val, p->sth2.val, S, p->D.val)),
-           dp, error(0.5L * (SQR(p->v_r) - p->R.val)),      // "H" = p_r^2 / 2 + (- R(r) / 2) = 0
-           dp, error(0.5L * (SQR(p->v_th) - p->TH.val)),   // "H" = p_th^2 / 2 + (- TH(th) / 2) = 0
-           dp, Y.a, dp, Y.b, p->tau, p->q_t);
+    real ra_sth = SQRT(p->ra2.val) * SIN(p->q_th);
+    real r[] = {ra_sth * COS(p->q_ph), ra_sth * SIN(p->q_ph), p->q_r * COS(p->q_th), mino,
+                error(RL(1.0) + v2(p->v_t, p->v_r, p->v_th, p->v_ph, p->a, p->ra2.val, p->sth2.val, S, p->D.val)),
+                error(RL(0.5) * (SQR(p->v_r) - p->R.val)),      // "H" = p_r^2 / 2 + (- R(r) / 2) = 0
+                error(RL(0.5) * (SQR(p->v_th) - p->TH.val)),   // "H" = p_th^2 / 2 + (- TH(th) / 2) = 0
+                Y.a, Y.b, p->tau, p->q_t};
+    if (c->binary) {
+        out_record(r, 11);
+        return;
+    }
+    int dp = c->dp;
+    char s[11][OUT_REAL];
+    for (int i = 0; i < 11; i++) out_real(s[i], " ", dp, r[i]);
+    printf("%s %s %s  %.6Le %s %s %s  %s %s  %.6Le %.6Le\n",
+           s[0], s[1], s[2], (long double)r[3], s[4], s[5], s[6], s[7], s[8], (long double)r[9], (long double)r[10]);
 }
 
 int main (int argc, char **argv) {
     controls *c = symp_get_c(argc, argv);
+    ckpt_init(argc, argv);
+    out_header(c, argc, argv, "x y z mino error_v error_r error_th gamma v tau t");
     solve(c, kerr_get_p(argc, argv, c->h), plot);
     return 0;
 }
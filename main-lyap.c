@@ -0,0 +1,19 @@
+/*
+ * Lyapunov spectrum, from the variational equations integrated alongside the model
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 8);
+
+    controls *c = tsm_get_c(argc, argv);
+    out_header(c, argc, argv, "l1 l2 l3 t");
+    lyap_tsm(c, tsm_init(argv, c->order), lyap_init(c->order), tsm_init_p(argc, argv, c->order), clock());
+
+    return 0;
+}
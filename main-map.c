@@ -0,0 +1,148 @@
+/*
+ * Chaos maps, a chaos indicator (fast Lyapunov indicator or largest Lyapunov exponent) for every point of a grid over
+ * two model parameters, tiles shared out on all cores, written as PGM & PFM images, and as text (or binary) records
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "taylor-ode.h"
+#include "output.h"
+#include "pool.h"
+
+#define TILE 16  // pixels on a side, big enough to keep the pool lock cold, small enough to share out the slow (chaotic) areas
+
+typedef struct Map {
+    int argc, ip, iq, width, height, tiles;
+    char **argv;
+    real p0, p1, q0, q1;
+    bool fli;
+    controls *c;
+    real *value;  // row major, row 0 at q0
+} map;
+
+typedef struct Local {
+    char **argv;
+    char p[OUT_REAL], q[OUT_REAL];
+    tangents *d;  // only the first deviation vector is used
+} local;
+
+static real axis (real lo, real hi, int i, int n) {
+    return lo + (hi - lo) * (real)i / (real)(n - 1);
+}
+
+static void *start (void *arg, int thread) { (void)thread;
+    const map *m = arg;
+    local *l = malloc(sizeof (local)); CHECK(l);
+    l->argv = malloc((size_t)m->argc * sizeof (char *)); CHECK(l->argv);
+    memcpy(l->argv, m->argv, (size_t)m->argc * sizeof (char *));
+    l->argv[m->ip] = l->p;
+    l->argv[m->iq] = l->q;
+    l->d = lyap_init(m->c->order);
+    return l;
+}
+
+static void work (void *arg, void *worker, int n) {
+    map *m = arg;
+    local *l = worker;
+    int across = (m->width + TILE - 1) / TILE;
+    int i0 = n % across * TILE, j0 = n / across * TILE;
+    for (int j = j0; j < j0 + TILE && j < m->height; j++) {
+        out_real(l->q, "", 0, axis(m->q0, m->q1, j, m->height));  // hex, exact
+        for (int i = i0; i < i0 + TILE && i < m->width; i++) {
+            out_real(l->p, "", 0, axis(m->p0, m->p1, i, m->width));
+            controls c = *m->c;
+            xyz *jets = tsm_init(l->argv, c.order);
+            model *mp = tsm_init_p(m->argc, l->argv, c.order);
+            m->value[j * m->width + i] = lyap_map(&c, jets, &l->d->v[0], mp, m->fli);
+            free(jets);  // one arena each
+            free(mp);
+        }
+    }
+}
+
+static void stop (void *arg, void *worker) { (void)arg;
+    local *l = worker;
+    free(l->d);
+    free(l->argv);
+    free(l);
+}
+
+static void images (const map *m, const char *name) {  // PGM scaled from the smallest to the largest value (0 if diverged), PFM as is
+    real lo = HUGE_VALR, hi = - HUGE_VALR;
+    for (int n = 0; n < m->width * m->height; n++) if (isfinite(m->value[n])) {
+        lo = FMIN(lo, m->value[n]);
+        hi = FMAX(hi, m->value[n]);
+    }
+    char *file = malloc(strlen(name) + 5); CHECK(file);
+    sprintf(file, "%s.pgm", name);
+    FILE *f = fopen(file, "wb"); CHECK(f);
+    fprintf(f, "P5\n%d %d\n255\n", m->width, m->height);
+    for (int j = m->height - 1; j >= 0; j--) for (int i = 0; i < m->width; i++) {  // top row first
+        real v = m->value[j * m->width + i];
+        fputc(!isfinite(v) ? 0 : hi > lo ? 1 + (int)(RL(254.0) * (v - lo) / (hi - lo) + RL(0.5)) : 128, f);
+    }
+    CHECK(!fclose(f));
+    sprintf(file, "%s.pfm", name);
+    f = fopen(file, "wb"); CHECK(f);
+    unsigned one = 1;
+    fprintf(f, "Pf\n%d %d\n%s\n", m->width, m->height, *(unsigned char *)&one ? "-1.0" : "1.0");  // bottom row first
+    for (int n = 0; n < m->width * m->height; n++) {
+        float v = (float)m->value[n];
+        CHECK(fwrite(&v, sizeof v, 1, f) == 1);
+    }
+    CHECK(!fclose(f));
+    free(file);
+}
+
+int main (int argc, char **argv) {
+    CHECK(argc > 16);
+    map *m = malloc(sizeof (map)); CHECK(m);
+    CHECK(!strcmp(argv[1], "fli") || !strcmp(argv[1], "mle"));
+    m->fli = !strcmp(argv[1], "fli");
+    m->p0 = STRTOR(argv[2], NULL);
+    m->p1 = STRTOR(argv[3], NULL);
+    m->width = (int)strtol(argv[4], NULL, BASE);   CHECK(m->width >= 2);
+    m->q0 = STRTOR(argv[5], NULL);
+    m->q1 = STRTOR(argv[6], NULL);
+    m->height = (int)strtol(argv[7], NULL, BASE);  CHECK(m->height >= 2);
+    char *name = argv[8];
+    m->argc = argc - 8;
+    m->argv = argv + 8;
+    m->argv[0] = argv[0];
+    m->ip = m->iq = 0;
+    for (int i = 5; i < m->argc; i++) {
+        if (!strcmp(m->argv[i], "$p")) m->ip = i;
+        if (!strcmp(m->argv[i], "$q")) m->iq = i;
+    }
+    CHECK(m->ip && m->iq);
+    m->argv[m->ip] = argv[2];  // placeholders for argument checks
+    m->argv[m->iq] = argv[5];
+    m->c = tsm_get_c(m->argc, m->argv);
+    out_header(m->c, m->argc, m->argv, "p q value");
+    m->value = malloc((size_t)m->width * (size_t)m->height * sizeof (real)); CHECK(m->value);
+    m->tiles = ((m->width + TILE - 1) / TILE) * ((m->height + TILE - 1) / TILE);
+    int threads = pool_run(0, m->tiles, start, work, stop, m);
+
+    images(m, name);
+    int dp = m->c->dp ? m->c->dp : 21, invalid = 0;
+    for (int j = 0; j < m->height; j++) {
+        for (int i = 0; i < m->width; i++) {
+            real p = axis(m->p0, m->p1, i, m->width), q = axis(m->q0, m->q1, j, m->height), v = m->value[j * m->width + i];
+            invalid += !isfinite(v);
+            if (m->c->binary) {
+                out_record((real []){p, q, v}, 3);
+            } else {
+                char s[OUT_REAL];
+                printf("%.9Le %.9Le %s\n", (long double)p, (long double)q, out_real(s, "+", dp, v));
+            }
+        }
+        if (!m->c->binary) printf("\n");  // gnuplot blocks, for splot or with image
+    }
+    fprintf(stderr, "%s%d%s x %s%d%s pixels, %s%d%s threads, %s%d%s diverged\n", WHT, m->width, GRY, WHT, m->height, GRY,
+            WHT, threads, GRY, invalid ? RED : WHT, invalid, NRM);
+    return 0;
+}
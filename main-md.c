@@ -0,0 +1,15 @@
+/*
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 8);
+
+    controls *c = md_get_c(argc, argv);
+    md_tsm(c, md_str(argv[3]), md_init(argv, c->order), tsm_init_p(argc, argv, c->order), clock());
+
+    return 0;
+}
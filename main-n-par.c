@@ -0,0 +1,29 @@
+/*
+ * N-variable TSM on a pool of threads, the first argument is the number of threads (0 for all cores)
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 6);
+    int threads = (int)strtol(argv[1], NULL, BASE); CHECK(threads >= 0);
+    if (!threads) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    CHECK(threads > 0);
+
+    argv[1] = argv[0];  // the rest is a normal tsmn-*-std command
+    argc--;
+    argv++;
+    controls *c = tsm_get_c(argc, argv);
+    state *s;
+    model *p = tsm_init_n(argc, argv, c->order, &s);
+    tsm_header_n(c, argc, argv, s);
+    tsm_n(c, s, p, threads, clock());
+
+    return 0;
+}
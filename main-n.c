@@ -0,0 +1,19 @@
+/*
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 5);
+
+    controls *c = tsm_get_c(argc, argv);
+    state *s;
+    model *p = tsm_init_n(argc, argv, c->order, &s);
+    tsm_header_n(c, argc, argv, s);
+    tsm_n(c, s, p, 1, clock());
+
+    return 0;
+}
@@ -8,18 +8,33 @@
 #include "symplectic.h"
 #include "h-nbody.h"
 
-static void plot (int dp, model *nb, real t) {
-    body *b = nb->bodies;
+static void plot (const controls *c, model *nb, real t) {
     reset_cog(nb);
-    printf("%.6Le % .*Le", t, dp, error(H(nb) - nb->h0));
+    if (!out_due(c)) return;
+    body *b = nb->bodies;
+    int dp = c->dp;
+    if (c->binary) {
+        out_record((real []){t, error(H(nb) - nb->h0)}, 2);
+        for (int i = 0; i < nb->n; i++) out_record((real []){b[i].x, b[i].y, b[i].z, b[i].px, b[i].py, b[i].pz}, 6);
+        return;
+    }
+    char s[6][OUT_REAL];
+    printf("%.6Le %s", (long double)t, out_real(s[0], " ", dp, error(H(nb) - nb->h0)));
     for (int i = 0; i < nb->n; i++) {
-        printf("  % .*Le % .*Le % .*Le % .*Le % .*Le % .*Le",
-                dp, b[i].x, dp, b[i].y, dp, b[i].z, dp, b[i].px, dp, b[i].py, dp, b[i].pz);
+        printf("  %s %s %s %s %s %s", out_real(s[0], " ", dp, b[i].x), out_real(s[1], " ", dp, b[i].y), out_real(s[2], " ", dp, b[i].z),
+               out_real(s[3], " ", dp, b[i].px), out_real(s[4], " ", dp, b[i].py), out_real(s[5], " ", dp, b[i].pz));
     }
     printf("\n");
 }
 
 int main (int argc, char **argv) {
-    solve(symp_get_c(argc, argv), get_p_nbody(argc, argv), plot);
+    controls *c = symp_get_c(argc, argv);
+    model *nb = get_p_nbody(argc, argv);
+    ckpt_init(argc, argv);
+    char columns[32 + 64 * nb->n];
+    int n = sprintf(columns, "t error");
+    for (int i = 0; i < nb->n; i++) n += sprintf(columns + n, " x%d y%d z%d px%d py%d pz%d", i, i, i, i, i, i);
+    out_header(c, argc, argv, columns);
+    solve(c, nb, plot);
     return 0 ;
 }
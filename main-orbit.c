@@ -0,0 +1,122 @@
+/*
+ * Periodic orbit finder, Newton shooting on the TSM flow and its monodromy matrix, from a guess at a point on the orbit
+ * and its period, for a point on a Poincare section that returns to itself; reports the period, the point and the
+ * Floquet multipliers
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+#define ITERATIONS 50
+
+static bool solve (real a[4][5]) {  // Gaussian elimination with partial pivoting, a is [A | b], solution in column 4
+    for (int i = 0; i < 4; i++) {
+        int m = i;
+        for (int r = i + 1; r < 4; r++) if (FABS(a[r][i]) > FABS(a[m][i])) m = r;
+        if (a[m][i] == RL(0.0)) return false;
+        for (int j = 0; j < 5; j++) {
+            real swap = a[i][j]; a[i][j] = a[m][j]; a[m][j] = swap;
+        }
+        for (int r = i + 1; r < 4; r++) {
+            real f = a[r][i] / a[i][i];
+            for (int j = i; j < 5; j++) a[r][j] -= f * a[i][j];
+        }
+    }
+    for (int i = 3; i >= 0; i--) {
+        for (int j = i + 1; j < 4; j++) a[i][4] -= a[i][j] * a[j][4];
+        a[i][4] /= a[i][i];
+    }
+    return true;
+}
+
+static void multipliers (real m[3][3], pair *mu) {  // eigenvalues (re, im) of m by the cubic formula, largest first
+    real tr = m[0][0] + m[1][1] + m[2][2];
+    real minors = m[0][0] * m[1][1] - m[0][1] * m[1][0] + m[0][0] * m[2][2] - m[0][2] * m[2][0] + m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    real det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    real s = tr / RL(3.0), P = minors - SQR(tr) / RL(3.0);  // lambda = t + s, t^3 + P t + Q = 0
+    real Q = - RL(2.0) * tr * SQR(tr) / RL(27.0) + tr * minors / RL(3.0) - det;
+    real D = SQR(Q / RL(2.0)) + P * SQR(P) / RL(27.0);
+    if (D > RL(0.0)) {  // one real, and a complex conjugate pair
+        real u = CBRT(- Q / RL(2.0) + SQRT(D)), v = CBRT(- Q / RL(2.0) - SQRT(D));
+        pair r = {u + v + s, RL(0.0)}, c = {- (u + v) / RL(2.0) + s, SQRT(RL(3.0)) / RL(2.0) * FABS(u - v)};
+        real size = SQR(c.a) + SQR(c.b);
+        if (SQR(r.a) >= size) {
+            mu[0] = r; mu[1] = c; mu[2] = (pair){c.a, - c.b};
+        } else {
+            if (size > RL(0.0)) r.a = det / size;  // the small one is better from the product of all three
+            mu[0] = c; mu[1] = (pair){c.a, - c.b}; mu[2] = r;
+        }
+        return;
+    }
+    real r = RL(2.0) * SQRT(- P / RL(3.0)), third = RL(2.0) * ACOS(- RL(1.0)) / RL(3.0);
+    real phi = r > RL(0.0) ? ACOS(FMAX(- RL(1.0), FMIN(RL(1.0), RL(3.0) * Q / (P * r)))) / RL(3.0) : RL(0.0);
+    for (int k = 0; k < 3; k++) mu[k] = (pair){r * COS(phi - third * k) + s, RL(0.0)};
+    for (int i = 0; i < 3; i++) for (int j = i + 1; j < 3; j++) if (FABS(mu[j].a) > FABS(mu[i].a)) {
+        pair swap = mu[i]; mu[i] = mu[j]; mu[j] = swap;
+    }
+    if (mu[0].a * mu[1].a != RL(0.0)) mu[2].a = det / (mu[0].a * mu[1].a);
+}
+
+int main (int argc, char **argv) {
+    CHECK(argc > 10);
+
+    event *e = tsm_event(argv[1]);                      CHECK(!e->slope);
+    real tolerance = STRTOR(argv[2], NULL);             CHECK(tolerance > RL(0.0));
+    argv[2] = argv[0];  // the rest is a normal tsm-*-std command, the run being one period
+    argc -= 2;
+    argv += 2;
+    controls *c = tsm_get_c(argc, argv);                CHECK(c->tol == RL(0.0) && c->h > RL(0.0) && c->steps > 0);
+    out_header(c, argc, argv, "x y z T m1 m1i m2 m2i m3 m3i");
+    xyz *jets = tsm_init(argv, c->order);
+    tangents *t = lyap_init(c->order);
+    model *p = tsm_init_p(argc, argv, c->order);
+
+    triplet u = {jets->x[0], jets->y[0], jets->z[0]};
+    real T = c->h * (real)c->steps, r = HUGE_VALR, speed = RL(0.0), m[3][3];
+    for (int i = 0; i <= ITERATIONS; i++) {
+        controls f = *c;
+        f.h = T / (real)c->steps;
+        triplet end = u, v;
+        tsm_flow(&f, jets, t, p, &end, &v);
+        for (int j = 0; j < 3; j++) {
+            m[0][j] = t->v[j].x[0];
+            m[1][j] = t->v[j].y[0];
+            m[2][j] = t->v[j].z[0];
+        }
+        real a[4][5] = {  // d(end - u, g(u)) / d(u, T) and minus the residual, for the Newton step
+            {m[0][0] - RL(1.0), m[0][1], m[0][2], v.x, u.x - end.x},
+            {m[1][0], m[1][1] - RL(1.0), m[1][2], v.y, u.y - end.y},
+            {m[2][0], m[2][1], m[2][2] - RL(1.0), v.z, u.z - end.z},
+            {e->a, e->b, e->c, RL(0.0), e->d - e->a * u.x - e->b * u.y - e->c * u.z}
+        };
+        r = FMAX(FMAX(FABS(a[0][4]), FABS(a[1][4])), FMAX(FABS(a[2][4]), FABS(a[3][4])));
+        speed = FMAX(FABS(v.x), FMAX(FABS(v.y), FABS(v.z)));
+        fprintf(stderr, "%siteration %s%d%s, residual %s%.3Le%s, period %s%.12Le%s\n", GRY, CYN, i, GRY, CYN, (long double)r, GRY, CYN, (long double)T, NRM);
+        if (r <= tolerance || i == ITERATIONS) break;
+        CHECK(solve(a));
+        u.x += a[0][4];
+        u.y += a[1][4];
+        u.z += a[2][4];
+        T += a[3][4];
+        CHECK(T > RL(0.0));
+    }
+    CHECK(r <= tolerance);
+    CHECK(speed > tolerance);  // not an equilibrium, which "closes" for any period
+
+    pair mu[3];
+    multipliers(m, mu);
+    if (c->binary) {
+        out_record((real []){u.x, u.y, u.z, T, mu[0].a, mu[0].b, mu[1].a, mu[1].b, mu[2].a, mu[2].b}, 10);
+    } else {
+        char x[OUT_REAL], y[OUT_REAL], z[OUT_REAL], period[OUT_REAL];
+        printf("%s %s %s %s", out_real(x, "+", c->dp, u.x), out_real(y, "+", c->dp, u.y), out_real(z, "+", c->dp, u.z), out_real(period, "", c->dp, T));
+        for (int j = 0; j < 3; j++) printf(" %s %s", out_real(x, "+", c->dp, mu[j].a), out_real(y, "+", c->dp, mu[j].b));
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Parareal (parallel in time) TSM, a cheap coarse propagator (low order, long steps) run serially across the time
+ * slices, corrected by the fine one (the requested order & step) run on all the slices at once, until the slice ends
+ * agree to a tolerance
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "taylor-ode.h"
+#include "output.h"
+#include "pool.h"
+
+typedef struct Fine {
+    xyz *jets;
+    model *p;
+} fine;
+
+typedef struct Parareal {
+    int slices;
+    controls *f;  // fine propagator controls, for one slice
+    triplet *u, *end;  // slice starting states (slices + 1, the last is the final state), fine slice end states
+    triplet **path;  // fine trajectory of each slice, at the output stride
+    fine *w;  // fine propagator jets & models, one per thread
+} parareal;
+
+static void *start (void *arg, int thread) {
+    parareal *s = arg;
+    return &s->w[thread];
+}
+
+static void work (void *arg, void *worker, int n) {
+    parareal *s = arg;
+    const fine *w = worker;
+    controls c = *s->f;
+    s->end[n] = s->u[n];
+    tsm_span(&c, w->jets, w->p, &s->end[n], s->path[n]);
+}
+
+static triplet coarse (const controls *g, xyz *jets, const model *q, triplet u) {
+    controls c = *g;
+    tsm_span(&c, jets, q, &u, NULL);
+    return u;
+}
+
+static void out (const controls *c, triplet u, real t, clock_t since) {
+    if (c->binary) {
+        out_record((real []){u.x, u.y, u.z, t}, 4);
+        return;
+    }
+    char x[OUT_REAL], y[OUT_REAL], z[OUT_REAL];
+    printf("%s %s %s %.6Le _ _ _ %.3Lf\n", out_real(x, "+", c->dp, u.x), out_real(y, "+", c->dp, u.y), out_real(z, "+", c->dp, u.z),
+           (long double)t, (long double)(clock() - since) / CLOCKS_PER_SEC);
+}
+
+int main (int argc, char **argv) {
+    CHECK(argc > 12);
+    clock_t t0 = clock();
+    parareal *s = malloc(sizeof (parareal)); CHECK(s);
+    s->slices = (int)strtol(argv[1], NULL, BASE);       CHECK(s->slices >= 1);
+    int order = (int)strtol(argv[2], NULL, BASE);       CHECK(order >= 2);
+    int ratio = (int)strtol(argv[3], NULL, BASE);       CHECK(ratio >= 1);
+    real tolerance = STRTOR(argv[4], NULL);             CHECK(tolerance > RL(0.0));
+    argv[4] = argv[0];  // the rest is a normal tsm-*-std command
+    argc -= 4;
+    argv += 4;
+    controls *c = tsm_get_c(argc, argv);                CHECK(c->tol == RL(0.0) && c->steps % s->slices == 0);
+    long span = c->steps / s->slices;                   CHECK(span % ratio == 0 && span % c->stride == 0);
+    out_header(c, argc, argv, "x y z t");
+
+    controls f = *c, g = *c;  // fine & coarse propagators for one slice
+    f.steps = span;
+    g.order = order;
+    g.h = c->h * ratio;
+    g.steps = span / ratio;
+    xyz *jets = tsm_init(argv, order);
+    model *q = tsm_init_p(argc, argv, order);
+
+    s->f = &f;
+    s->u = malloc((size_t)(s->slices + 1) * sizeof (triplet)); CHECK(s->u);
+    s->end = malloc((size_t)s->slices * sizeof (triplet)); CHECK(s->end);
+    s->path = malloc((size_t)s->slices * sizeof (triplet *)); CHECK(s->path);
+    for (int n = 0; n < s->slices; n++) {
+        s->path[n] = malloc((size_t)(span / c->stride + 1) * sizeof (triplet)); CHECK(s->path[n]);
+    }
+    int threads = pool_threads(s->slices);  // the most any iteration uses
+    s->w = malloc((size_t)threads * sizeof (fine)); CHECK(s->w);
+    for (int i = 0; i < threads; i++) s->w[i] = (fine){tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order)};
+
+    triplet *G = malloc((size_t)s->slices * sizeof (triplet)); CHECK(G);  // coarse slice end states, last iteration
+    s->u[0] = (triplet){jets->x[0], jets->y[0], jets->z[0]};
+    for (int n = 0; n < s->slices; n++) s->u[n + 1] = G[n] = coarse(&g, jets, q, s->u[n]);
+    for (int k = 0; k < s->slices; k++) {  // slices up to k start from the fine solution, so need no more work
+        pool_run(k, s->slices, start, work, NULL, s);
+        real delta = RL(0.0);
+        for (int n = k; n < s->slices; n++) {  // serial correction, fine + (new coarse - old coarse), exact at n = k
+            triplet new = coarse(&g, jets, q, s->u[n]);
+            triplet u = {s->end[n].x + (new.x - G[n].x), s->end[n].y + (new.y - G[n].y), s->end[n].z + (new.z - G[n].z)};
+            G[n] = new;
+            delta = FMAX(delta, FMAX(FABS(u.x - s->u[n + 1].x), FMAX(FABS(u.y - s->u[n + 1].y), FABS(u.z - s->u[n + 1].z))));
+            s->u[n + 1] = u;
+        }
+        fprintf(stderr, "%siteration %s%d%s, delta %s%.3Le%s\n", GRY, CYN, k + 1, GRY, CYN, (long double)delta, NRM);
+        if (delta <= tolerance) break;
+    }
+
+    for (int n = 0; n < s->slices; n++) {  // the last fine trajectories, within tolerance of the converged slice starts
+        for (long j = 0; j < span / c->stride; j++) out(c, s->path[n][j], c->h * (real)(n * span + j * c->stride), t0);
+    }
+    out(c, s->path[s->slices - 1][span / c->stride], c->h * (real)c->steps, t0);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Bifurcation (chaos scanning) diagrams, sweeping one model parameter across a range on all cores
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taylor-ode.h"
+#include "output.h"
+#include "pool.h"
+
+typedef struct Scan {
+    int argc, index, values, samples;
+    char **argv;
+    real start, end;
+    controls *c;
+    turning **tp;
+    int *n;
+    bool *valid;
+} scan;
+
+typedef struct Local {
+    char **argv;
+    char value[OUT_REAL];
+} local;
+
+static void *start (void *arg, int thread) { (void)thread;
+    const scan *s = arg;
+    local *l = malloc(sizeof (local)); CHECK(l);
+    l->argv = malloc((size_t)s->argc * sizeof (char *)); CHECK(l->argv);
+    memcpy(l->argv, s->argv, (size_t)s->argc * sizeof (char *));
+    l->argv[s->index] = l->value;
+    return l;
+}
+
+static void work (void *arg, void *worker, int i) {
+    scan *s = arg;
+    local *l = worker;
+    out_real(l->value, "", 0, s->start + (s->end - s->start) * i / s->values);  // hex, exact
+    controls c = *s->c;
+    xyz *jets = tsm_init(l->argv, c.order);
+    model *p = tsm_init_p(s->argc, l->argv, c.order);
+    s->valid[i] = tsm_tp(&c, jets, p, s->samples, &s->tp[i], &s->n[i]);
+    free(jets);  // one arena each
+    free(p);
+}
+
+static void stop (void *arg, void *worker) { (void)arg;
+    local *l = worker;
+    free(l->argv);
+    free(l);
+}
+
+int main (int argc, char **argv) {
+    CHECK(argc > 12);
+    scan *s = malloc(sizeof (scan)); CHECK(s);
+    s->start = STRTOR(argv[1], NULL);
+    s->end = STRTOR(argv[2], NULL);
+    s->values = (int)strtol(argv[3], NULL, BASE);  CHECK(s->values > 0);
+    s->samples = (int)strtol(argv[4], NULL, BASE); CHECK(s->samples > 0);
+    s->argc = argc - 4;
+    s->argv = argv + 4;
+    s->argv[0] = argv[0];
+    s->index = 0;
+    for (int i = 5; i < s->argc; i++) if (!strcmp(s->argv[i], "$p")) s->index = i;
+    CHECK(s->index);
+    s->argv[s->index] = argv[1];  // placeholder for argument checks
+    s->c = tsm_get_c(s->argc, s->argv);
+    s->tp = malloc((size_t)(s->values + 1) * sizeof (turning *)); CHECK(s->tp);
+    s->n = malloc((size_t)(s->values + 1) * sizeof (int)); CHECK(s->n);
+    s->valid = malloc((size_t)(s->values + 1) * sizeof (bool)); CHECK(s->valid);
+    int threads = pool_run(0, s->values + 1, start, work, stop, s);
+
+    int dp = s->c->dp ? s->c->dp : 21, invalid = 0;
+    for (int i = 0; i <= s->values; i++) {
+        invalid += !s->valid[i];  // no turning points then
+        long double p = (long double)(s->start + (s->end - s->start) * i / s->values);
+        char v[OUT_REAL];
+        for (int j = 0; j < s->n[i]; j++) printf("%.9Le %s %c\n", p, out_real(v, "+", dp, s->tp[i][j].value), s->tp[i][j].tag);
+        free(s->tp[i]);
+    }
+    fprintf(stderr, "%s%d%s values, %s%d%s threads, %s%d%s diverged\n", WHT, s->values + 1, GRY, WHT, threads, GRY, invalid ? RED : WHT, invalid, NRM);
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Forward parameter sensitivities, d(x, y, z)/dp for the chosen model parameters, carried alongside the trajectory
+ * as tangent jets in a single run
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taylor-ode.h"
+#include "output.h"
+
+int main (int argc, char **argv) {
+    CHECK(argc > 9);
+
+    CHECK(*argv[1]);
+    int n = 1, *which = malloc((strlen(argv[1]) + 1) * sizeof (int)); CHECK(which);  // no more than one per comma
+    char *end = argv[1];
+    for (which[0] = (int)strtol(end, &end, BASE); *end == ','; n++) which[n] = (int)strtol(end + 1, &end, BASE);
+    CHECK(*end == '\0');
+    argv[1] = argv[0];  // the rest is a normal tsm-*-std command
+    argc--;
+    argv++;
+    char *columns = malloc((size_t)n * 24 + 8); CHECK(columns);
+    char *s = columns + sprintf(columns, "x y z t");
+    for (int j = 0; j < n; j++) {
+        CHECK(which[j] >= 1 && which[j] <= argc - 8);
+        s += sprintf(s, " dx/p%d dy/p%d dz/p%d", which[j], which[j], which[j]);
+        which[j]--;  // command position, from 1, to ode_p() index
+    }
+    controls *c = tsm_get_c(argc, argv);
+    out_header(c, argc, argv, columns);
+    sens_tsm(c, tsm_init(argv, c->order), sens_init(n, which, c->order), tsm_init_p(argc, argv, c->order), clock());
+
+    return 0;
+}
@@ -4,11 +4,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
+#include "output.h"
 
 int main (int argc, char **argv) {
     CHECK(argc > 8);
 
     controls *c = tsm_get_c(argc, argv);
+    ckpt_init(argc, argv);
+    out_header(c, argc, argv, "x y z t");
     tsm(c, tsm_init(argv, c->order), tsm_init_p(argc, argv, c->order), clock());
 
     return 0;
@@ -0,0 +1,410 @@
+/*
+ * Double-double and quad-double arithmetic, from error-free transformations and renormalisation, with TSM on top
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include "multi-double.h"
+#include "output.h"
+
+#define EPSILON ldexp(1.0, -53 * MD_LIMBS)
+#define TERMS (2 * MD_LIMBS * (MD_LIMBS + 1))
+
+static const char *LN2 = "0.69314718055994530941723212145817656807550013436025525412068000949339362196969471560586332699641869";
+static const char *PI_2 = "1.57079632679489661923132169163975144209858469968755291048747229615390820314310449931401741267105854";
+
+static inline double _two_sum_ (double a, double b, double *e) {
+    double s = a + b, v = s - a;
+    *e = (a - (s - v)) + (b - v);
+    return s;
+}
+
+static inline double _fast_two_sum_ (double a, double b, double *e) {  // |a| >= |b|
+    double s = a + b;
+    *e = b - (s - a);
+    return s;
+}
+
+#ifdef FP_FAST_FMA
+static inline double _two_prod_ (double a, double b, double *e) {
+    double p = a * b;
+    *e = fma(a, b, -p);
+    return p;
+}
+#else
+static inline void _split_ (double a, double *hi, double *lo) {  // Veltkamp
+    double t = 134217729.0 * a;
+    *hi = t - (t - a);
+    *lo = a - *hi;
+}
+
+static inline double _two_prod_ (double a, double b, double *e) {  // Dekker
+    double p = a * b, ah, al, bh, bl;
+    _split_(a, &ah, &al);
+    _split_(b, &bh, &bl);
+    *e = ((ah * bh - p) + ah * bl + al * bh) + al * bl;
+    return p;
+}
+#endif
+
+static md _renorm_ (const double *x, int m) {  // m terms in (roughly) decreasing magnitude, VecSum then VecSumErrBranch
+    double e[TERMS];
+    double s = x[m - 1];
+    for (int i = m - 2; i >= 0; i--) s = _two_sum_(x[i], s, &e[i + 1]);
+    e[0] = s;
+    md _ = {{0.0}};
+    int j = 0;
+    double eps = e[0];
+    for (int i = 1; i < m; i++) {
+        double err;
+        _.d[j] = _fast_two_sum_(eps, e[i], &err);
+        if (err != 0.0) {
+            if (j == MD_LIMBS - 1) return _;
+            j++;
+            eps = err;
+        } else {
+            eps = _.d[j];
+        }
+    }
+    if (eps != 0.0 && j < MD_LIMBS) _.d[j] = eps;
+    return _;
+}
+
+md md_d (double a) {
+    md _ = {{a}};
+    return _;
+}
+
+md md_neg (md a) {
+    for (int i = 0; i < MD_LIMBS; i++) a.d[i] = - a.d[i];
+    return a;
+}
+
+md md_add (md a, md b) {
+    double x[2 * MD_LIMBS];
+    for (int i = 0, j = 0, n = 0; n < 2 * MD_LIMBS; n++) {
+        x[n] = j == MD_LIMBS || (i < MD_LIMBS && fabs(a.d[i]) >= fabs(b.d[j])) ? a.d[i++] : b.d[j++];
+    }
+    return _renorm_(x, 2 * MD_LIMBS);
+}
+
+md md_sub (md a, md b) {
+    return md_add(a, md_neg(b));
+}
+
+md md_mul (md a, md b) {
+    double p[MD_LIMBS][MD_LIMBS], e[MD_LIMBS][MD_LIMBS], x[TERMS];
+    for (int i = 0; i < MD_LIMBS; i++) {
+        for (int j = 0; j < MD_LIMBS; j++) {
+            if (i + j < MD_LIMBS) p[i][j] = _two_prod_(a.d[i], b.d[j], &e[i][j]);
+            else if (i + j == MD_LIMBS) p[i][j] = a.d[i] * b.d[j];
+        }
+    }
+    int n = 0;
+    for (int l = 0; l <= MD_LIMBS; l++) {  // level l, the products with i + j = l and the errors of those with l - 1
+        for (int i = 0; i <= l && i < MD_LIMBS; i++) if (l - i < MD_LIMBS) x[n++] = p[i][l - i];
+        for (int i = 0; i < l; i++) if (l - 1 - i < MD_LIMBS) x[n++] = e[i][l - 1 - i];
+    }
+    return _renorm_(x, n);
+}
+
+md md_mul_d (md a, double b) {
+    double p[MD_LIMBS], e[MD_LIMBS], x[2 * MD_LIMBS];
+    for (int i = 0; i < MD_LIMBS; i++) p[i] = _two_prod_(a.d[i], b, &e[i]);
+    int n = 0;
+    x[n++] = p[0];
+    for (int i = 1; i < MD_LIMBS; i++) {  // the error of each limb goes with the next
+        x[n++] = p[i];
+        x[n++] = e[i - 1];
+    }
+    x[n++] = e[MD_LIMBS - 1];
+    return _renorm_(x, n);
+}
+
+md md_div (md a, md b) {  // long division, one double of quotient at a time
+    CHECK(b.d[0] != 0.0);
+    double q[MD_LIMBS + 1];
+    for (int i = 0; i <= MD_LIMBS; i++) {
+        q[i] = a.d[0] / b.d[0];
+        a = md_sub(a, md_mul_d(b, q[i]));
+    }
+    return _renorm_(q, MD_LIMBS + 1);
+}
+
+static md _scale_ (md a, int e) {  // a * 2^e, exact
+    for (int i = 0; i < MD_LIMBS; i++) a.d[i] = ldexp(a.d[i], e);
+    return a;
+}
+
+static double _floor_ (md a) {
+    double _ = floor(a.d[0]);
+    if (_ != a.d[0]) return _;
+    for (int i = 1; i < MD_LIMBS; i++) if (a.d[i] != 0.0) return a.d[i] < 0.0 ? _ - 1.0 : _;
+    return _;
+}
+
+static md _pow10_ (int e) {
+    md _ = md_d(1.0), p = md_d(10.0);
+    for (int n = abs(e); n; n >>= 1, p = md_mul(p, p)) if (n & 1) _ = md_mul(_, p);
+    return e < 0 ? md_div(md_d(1.0), _) : _;
+}
+
+md md_str (const char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    bool minus = *s == '-';
+    if (*s == '-' || *s == '+') s++;
+    md _ = md_d(0.0);
+    int digits = 0, e = 0;
+    for (bool point = false; isdigit((unsigned char)*s) || (*s == '.' && !point); s++) {
+        if (*s == '.') {
+            point = true;
+            continue;
+        }
+        _ = md_add(md_mul_d(_, 10.0), md_d(*s - '0'));
+        digits++;
+        if (point) e--;
+    }
+    CHECK(digits);
+    if (*s == 'e' || *s == 'E') e += (int)strtol(s + 1, NULL, BASE);
+    if (e) _ = e < 0 ? md_div(_, _pow10_(- e)) : md_mul(_, _pow10_(e));
+    return minus ? md_neg(_) : _;
+}
+
+void md_print (md a, int dp) {
+    if (!dp) dp = MD_DIGITS;
+    char *s = malloc((size_t)dp + 16); CHECK(s);
+    int *digit = malloc(((size_t)dp + 2) * sizeof (int)); CHECK(digit);
+    putchar(a.d[0] < 0.0 ? '-' : '+');
+    if (a.d[0] < 0.0) a = md_neg(a);
+    int e = 0;
+    if (a.d[0] != 0.0) {
+        e = (int)floor(log10(a.d[0]));
+        a = md_mul(a, _pow10_(- e));
+        if (a.d[0] >= 10.0) {
+            a = md_div(a, md_d(10.0));
+            e++;
+        } else if (a.d[0] < 1.0) {
+            a = md_mul_d(a, 10.0);
+            e--;
+        }
+    }
+    for (int i = 0; i <= dp + 1; i++) {  // one extra for rounding
+        double d = _floor_(a);
+        digit[i] = (int)d;
+        a = md_mul_d(md_sub(a, md_d(d)), 10.0);
+    }
+    if (digit[dp + 1] >= 5) {
+        int i = dp;
+        for (; i >= 0 && digit[i] == 9; i--) digit[i] = 0;
+        if (i >= 0) {
+            digit[i]++;
+        } else {
+            digit[0] = 1;
+            e++;
+        }
+    }
+    int n = sprintf(s, "%d.", digit[0]);
+    for (int i = 1; i <= dp; i++) s[n++] = (char)('0' + digit[i]);
+    sprintf(s + n, "e%+03d", e);
+    fputs(s, stdout);
+    free(digit);
+    free(s);
+}
+
+static md _constant_ (const char *value, md *cache, bool *done) {
+    if (!*done) {
+        *cache = md_str(value);
+        *done = true;
+    }
+    return *cache;
+}
+
+md md_exp (md a) {
+    static md ln2;
+    static bool done = false;
+    if (a.d[0] == 0.0) return md_d(1.0);
+    CHECK(fabs(a.d[0]) < 709.0);
+    double m = floor(a.d[0] / 0.6931471805599453 + 0.5);
+    md r = _scale_(md_sub(a, md_mul_d(_constant_(LN2, &ln2, &done), m)), -10), p = r, t = r;  // p = exp(r) - 1
+    for (int i = 2; fabs(t.d[0]) > EPSILON * fabs(p.d[0]); i++) {
+        t = md_div(md_mul(t, r), md_d(i));
+        p = md_add(p, t);
+    }
+    for (int i = 0; i < 10; i++) p = md_add(md_mul_d(p, 2.0), md_mul(p, p));  // (1 + p)^2 - 1
+    return _scale_(md_add(md_d(1.0), p), (int)m);
+}
+
+static mpair _taylor_sc_ (md r, bool trig) {  // sin & cos or sinh & cosh by Taylor Series, for small r
+    md r2 = trig ? md_neg(md_mul(r, r)) : md_mul(r, r), s = r, c = md_d(1.0), ts = r, tc = c;
+    for (int i = 1; fabs(ts.d[0]) > EPSILON * fabs(s.d[0]) || fabs(tc.d[0]) > EPSILON * fabs(c.d[0]); i += 2) {
+        tc = md_div(md_mul(tc, r2), md_d(i * (i + 1)));
+        ts = md_div(md_mul(ts, r2), md_d((i + 1) * (i + 2)));
+        c = md_add(c, tc);
+        s = md_add(s, ts);
+    }
+    return (mpair){s, c};
+}
+
+mpair md_sin_cos (md a, bool trig) {
+    if (a.d[0] == 0.0) return (mpair){md_d(0.0), md_d(1.0)};
+    if (!trig) {
+        if (fabs(a.d[0]) < 0.5) return _taylor_sc_(a, false);
+        md e = md_exp(a), i = md_div(md_d(1.0), e);
+        return (mpair){_scale_(md_sub(e, i), -1), _scale_(md_add(e, i), -1)};
+    }
+    static md pi_2;
+    static bool done = false;
+    md half_pi = _constant_(PI_2, &pi_2, &done);
+    double j = floor(a.d[0] / half_pi.d[0] + 0.5);
+    mpair _ = _taylor_sc_(md_sub(a, md_mul_d(half_pi, j)), true);
+    switch ((int)(j - 4.0 * floor(j / 4.0))) {
+        case 1: return (mpair){_.b, md_neg(_.a)};
+        case 2: return (mpair){md_neg(_.a), md_neg(_.b)};
+        case 3: return (mpair){md_neg(_.b), _.a};
+        default: return _;
+    }
+}
+
+controls *md_get_c (int argc, char **argv) {
+    PRINT_ARGS(argc, argv);
+    controls *_ = malloc(sizeof (controls)); CHECK(_);
+    out_get_c(_, argv[1]);                       CHECK(_->dp >= 0);
+    CHECK(!_->binary);  // text only, records of reals would lose the precision
+    _->order = (int)strtol(argv[2], NULL, BASE);
+    _->h = STRTOR(argv[3], NULL);               CHECK(_->h != RL(0.0));
+    _->tol = _->h < RL(0.0) ? - _->h : RL(0.0);        CHECK(_->tol < RL(1.0));
+    if (!_->order && _->tol > RL(0.0)) _->order = (int)CEIL(RL(1.0) - RL(0.5) * LOG(_->tol));  // Jorba & Zou
+    CHECK(_->order >= 2 && _->order <= 64);
+    _->steps = strtol(argv[4], NULL, BASE);      CHECK(_->steps >= 0);
+    _->looping = false;
+    return _;
+}
+
+mseries md_jet (int n) {
+    CHECK(n > 0);
+    mseries _ = malloc((size_t)n * sizeof (md)); CHECK(_);
+    for (int i = 0; i < n; i++) _[i] = md_d(0.0);
+    return _;
+}
+
+mxyz *md_init (char **argv, int o) {
+    mxyz *_ = malloc(sizeof (mxyz)); CHECK(_);
+    _->x = md_jet(o + 1); _->x[0] = md_str(argv[5]);
+    _->y = md_jet(o + 1); _->y[0] = md_str(argv[6]);
+    _->z = md_jet(o + 1); _->z[0] = md_str(argv[7]);
+    return _;
+}
+
+void md_get_p (char **argv, int argc, ...) {
+    va_list _;
+    va_start(_, argc);
+    for (int i = 8; i < argc; i++) *va_arg(_, md *) = md_str(argv[i]);
+    va_end(_);
+}
+
+static md _horner_ (const mseries u, int o, md h) {
+    md _ = u[o];
+    for (int i = o - 1; i >= 0; i--) _ = md_add(md_mul(_, h), u[i]);
+    CHECK(isfinite(_.d[0]));
+    return _;
+}
+
+static double _step_size_ (const mxyz *_, int o, double tol) {  // Jorba & Zou, from the last two coefficients
+    double h = HUGE_VAL;
+    for (int k = o - 1; k <= o; k++) {
+        double norm = fmax(fabs(_->x[k].d[0]), fmax(fabs(_->y[k].d[0]), fabs(_->z[k].d[0])));
+        if (norm > 0.0) h = fmin(h, pow(tol / norm, 1.0 / k));
+    }
+    return isfinite(h) ? h : 1.0;
+}
+
+static char _tp_ (const mseries u, double *v_old, char min) {
+    char tag = *v_old * u[1].d[0] >= 0.0 ? '_' : (u[2].d[0] > 0.0 ? min : (char)toupper(min));
+    *v_old = u[1].d[0];
+    return tag;
+}
+
+static void _out_ (const controls *c, const mxyz *_, md t, char x_tag, char y_tag, char z_tag, clock_t since) {
+    md_print(_->x[0], c->dp);
+    putchar(' ');
+    md_print(_->y[0], c->dp);
+    putchar(' ');
+    md_print(_->z[0], c->dp);
+    printf(" %.6e %c %c %c %.3Lf\n", t.d[0], x_tag, y_tag, z_tag, (long double)(clock() - since) / CLOCKS_PER_SEC);
+}
+
+void md_tsm (controls *c, md h, mxyz *_, const model *p, clock_t since) {
+    double vX = 0.0, vY = 0.0, vZ = 0.0, tol = (double)c->tol;
+    md t = md_d(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        for (int k = 0; k < c->order; k++) {
+            mtriplet v = ode(_->x, _->y, _->z, p, k);
+            _->x[k + 1] = md_div(v.x, md_d(k + 1));
+            _->y[k + 1] = md_div(v.y, md_d(k + 1));
+            _->z[k + 1] = md_div(v.z, md_d(k + 1));
+        }
+        char x_tag = _tp_(_->x, &vX, 'x'), y_tag = _tp_(_->y, &vY, 'y'), z_tag = _tp_(_->z, &vZ, 'z');
+        if (out_due(c)) _out_(c, _, t, x_tag, y_tag, z_tag, since);
+        md step = tol > 0.0 ? md_d(_step_size_(_, c->order, tol)) : h;
+        _->x[0] = _horner_(_->x, c->order, step);
+        _->y[0] = _horner_(_->y, c->order, step);
+        _->z[0] = _horner_(_->z, c->order, step);
+        t = tol > 0.0 ? md_add(t, step) : md_mul_d(h, (double)(c->step + 1));
+    }
+    _out_(c, _, t, '_', '_', '_', since);
+}
+
+md m_const (md value, int k) {
+    return k ? md_d(0.0) : value;
+}
+
+md m_abs (const mseries u, int k) {
+    if (!k) CHECK(u[0].d[0] != 0.0);
+    return u[0].d[0] < 0.0 ? md_neg(u[k]) : u[k];
+}
+
+md m_mul (const mseries u, const mseries v, int k) {
+    md _ = md_d(0.0);
+    for (int j = 0; j <= k; j++) _ = md_add(_, md_mul(u[j], v[k - j]));
+    return _;
+}
+
+md m_sqr (const mseries u, int k) {
+    md _ = md_d(0.0);
+    for (int j = 0; j < k - j; j++) _ = md_add(_, md_mul(u[j], u[k - j]));
+    _ = md_mul_d(_, 2.0);
+    return k % 2 ? _ : md_add(_, md_mul(u[k / 2], u[k / 2]));
+}
+
+static md _chain_ (const mseries dfdu, const mseries u, int k, double scale) {
+    md _ = md_d(0.0);
+    for (int j = 0; j < k; j++) _ = md_add(_, md_mul(dfdu[j], md_mul_d(u[k - j], k - j)));
+    return md_div(md_mul_d(_, scale), md_d(k));
+}
+
+md m_exp (mseries e, const mseries u, int k) {
+    if (k) return e[k] = _chain_(e, u, k, 1.0);
+    CHECK(e != u);
+    return e[k] = md_exp(u[k]);
+}
+
+mpair m_sin_cos (mseries s, mseries c, const mseries u, int k, bool trig) {
+    if (k) return (mpair){ s[k] = _chain_(c, u, k, 1.0), c[k] = _chain_(s, u, k, trig ? -1.0 : 1.0) };
+    CHECK(s != c && s != u && c != u);
+    mpair _ = md_sin_cos(u[k], trig);
+    return (mpair){ s[k] = _.a, c[k] = _.b };
+}
+
+mpair m_tan_sec2 (mseries t, mseries s, const mseries u, int k, bool trig) {
+    if (k) return (mpair){ t[k] = _chain_(s, u, k, 1.0), s[k] = _chain_(t, t, k, trig ? 2.0 : -2.0) };
+    CHECK(t != s && t != u && s != u);
+    CHECK(trig ? fabs(u[0].d[0]) < 1.5707963267948966 : true);
+    mpair sc = md_sin_cos(u[k], trig);
+    t[k] = md_div(sc.a, sc.b);
+    md t2 = md_mul(t[k], t[k]);
+    return (mpair){ t[k], s[k] = trig ? md_add(md_d(1.0), t2) : md_sub(md_d(1.0), t2) };
+}
@@ -0,0 +1,144 @@
+/*
+ * Double-double (MD_LIMBS 2, about 32 digits) and quad-double (MD_LIMBS 4, about 64 digits) arithmetic, with the Taylor
+ * Series recurrences and TSM built on it, for high precision (e.g. CNS reference) runs of the models
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#pragma once
+#include <time.h>
+#include "real.h"
+
+#ifndef MD_LIMBS
+#define MD_LIMBS 2
+#endif
+
+/*
+ * Decimal digits output by default (dp 0)
+ */
+#define MD_DIGITS (16 * MD_LIMBS - 1)
+
+/*
+ * Multi-double number, the unevaluated sum of MD_LIMBS non-overlapping doubles, largest first
+ */
+typedef struct Md {
+    double d[MD_LIMBS];
+} md;
+
+/*
+ * Type for multi-double Taylor Series coordinate jets
+ */
+typedef md *mseries;
+
+/*
+ * Combined x, y, z series
+ */
+typedef struct Md3 {
+    mseries x, y, z;
+} mxyz;
+
+/*
+ * For returning combined values from trig/hyp functions
+ */
+typedef struct MdPair {
+    md a, b;
+} mpair;
+
+/*
+ * Triple of multi-doubles, by coordinate
+ */
+typedef struct MdTriple {
+    md x, y, z;
+} mtriplet;
+
+/*
+ * Arithmetic
+ */
+md md_d (double a);
+
+md md_neg (md a);
+
+md md_add (md a, md b);
+
+md md_sub (md a, md b);
+
+md md_mul (md a, md b);
+
+md md_div (md a, md b);
+
+/*
+ * Product with a double, exact if that is a small integer
+ */
+md md_mul_d (md a, double b);
+
+/*
+ * Exact, decimal strings in the style of strtod()
+ */
+md md_str (const char *s);
+
+/*
+ * Writes a to stdout in the style of printf("%+.*e", dp, a), all MD_DIGITS if dp is 0
+ */
+void md_print (md a, int dp);
+
+md md_exp (md a);
+
+/*
+ * Returns both SIN/SINH and COS/COSH of a
+ */
+mpair md_sin_cos (md a, bool trig);
+
+/*
+ * Retrieves control parameters from the first four command arguments, as tsm_get_c()
+ */
+controls *md_get_c (int argc, char **argv);
+
+/*
+ * Retrieves initial X, Y, Z values from the next three command arguments and populates their Taylor Series'
+ */
+mxyz *md_init (char **argv, int order);
+
+/*
+ * Retrieves ODE model parameters from the tail of the command (argument 8 onwards)
+ */
+void md_get_p (char **argv, int count, ...);
+
+/*
+ * Creates a Taylor Series with the specified number of elements
+ */
+mseries md_jet (int size);
+
+/*
+ *  Run TSM with the step size (or tolerance) H read exactly from the command, send data to stdout as for tsm()
+ */
+void md_tsm (controls *c, md h, mxyz *jets, const model *p, clock_t since);
+
+/*
+ * Taylor Series recurrences, as their t_*() namesakes in taylor-ode.h
+ */
+md m_const (md value, int k);
+
+md m_abs (const mseries U, int k);
+
+md m_mul (const mseries U, const mseries W, int k);
+
+md m_sqr (const mseries U, int k);
+
+md m_exp (mseries EXP, const mseries U, int k);
+
+mpair m_sin_cos (mseries SIN, mseries COS, const mseries U, int k, bool trig);
+
+mpair m_tan_sec2 (mseries TAN, mseries SEC2, const mseries U, int k, bool trig);
+
+/*
+ * Obligatory client method signatures (generated as tsm-<model>-md.c by tsm-compile.py)
+ */
+
+/*
+ * Populate parameter data from command arguments
+ */
+model *tsm_init_p (int argc, char **argv, int order);
+
+/*
+ * Calculate kth components of the velocity V, using the ODE model together with the functions above as necessary
+ */
+mtriplet ode (mseries X, mseries Y, mseries Z, const model *p, const int k);
@@ -167,6 +167,6 @@ void osd_summary () {
     sprintf(hud, "Elapsed: %.1fs  CPU: %.1fs  %.0f%%",
                   elapsed = finished ? elapsed : 0.001F * (float)glutGet(GLUT_ELAPSED_TIME),
                   cpu = finished ? cpu : (float)(clock() - since) / CLOCKS_PER_SEC,
-                  (float)(100.0L * c->step / c->steps));
+                  (float)(RL(100.0) * (real)c->step / (real)c->steps));
     osd(10, 10, hud);
 }
@@ -0,0 +1,137 @@
+/*
+ * Trajectory output selection, binary records and checkpoints
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L  // open_memstream(), fileno(), fsync(), ftruncate()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "output.h"
+
+typedef struct Checkpoint {
+    char *file, *temp, *header;  // checkpoint, its replacement while being written, and the command it belongs to
+    long every;
+    bool resume;
+} checkpoint;
+
+static checkpoint _ckpt_ = {NULL, NULL, NULL, 0, false};
+
+static volatile sig_atomic_t _signal_ = 0;
+
+void out_get_c (controls *c, const char *arg) {
+    char *end;
+    c->binary = *arg == 'b';
+    c->dp = (int)strtol(c->binary ? arg + 1 : arg, &end, BASE);
+    c->stride = *end == ':' ? (int)strtol(end + 1, NULL, BASE) : 1; CHECK(c->stride >= 1);
+}
+
+bool out_due (const controls *c) {
+    return c->step % c->stride == 0 || c->step == c->steps;
+}
+
+char *out_real (char *s, const char *flags, int dp, real r) {
+    char f[16];
+#ifdef REAL_F128
+    CHECK(snprintf(f, sizeof f, dp ? "%%%s.*Qe" : "%%%sQa", flags) < (int)sizeof f);
+    int n = dp ? quadmath_snprintf(s, OUT_REAL, f, dp, r) : quadmath_snprintf(s, OUT_REAL, f, r);
+#else
+    CHECK(snprintf(f, sizeof f, dp ? "%%%s.*Le" : "%%%sLa", flags) < (int)sizeof f);
+    int n = dp ? snprintf(s, OUT_REAL, f, dp, (long double)r) : snprintf(s, OUT_REAL, f, (long double)r);
+#endif
+    CHECK(n > 0 && n < OUT_REAL);
+    return s;
+}
+
+void out_header (const controls *c, int argc, char **argv, const char *columns) {
+    if (!c->binary || _ckpt_.resume) return;
+    const char *name = strrchr(argv[0], '/');
+    int n = 0;
+    for (const char *s = columns; *s; s++) if (*s != ' ' && (s == columns || s[-1] == ' ')) n++;
+    unsigned one = 1;
+    printf("#!tsm-records 1\nmodel %s\nargs", name ? name + 1 : argv[0]);
+    for (int i = 0; i < argc; i++) printf(" %s", argv[i]);
+    printf("\ncontrols order %d h %.6Le steps %ld stride %d\n", c->order, (long double)c->h, c->steps, c->stride);
+    printf("real %zu %d %s\n", sizeof (real), REAL_MANT_DIG, *(unsigned char *)&one ? "little" : "big");
+    printf("columns %d %s\nend\n", n, columns);
+}
+
+void out_record (const real *r, int n) {
+    CHECK(fwrite(r, sizeof (real), (size_t)n, stdout) == (size_t)n);
+}
+
+void ckpt_init (int argc, char **argv) {
+    const char *env = getenv("CHECKPOINT");
+    if (!env || !*env) return;
+    const char *colon = strrchr(env, ':');
+    size_t len = colon ? (size_t)(colon - env) : strlen(env);
+    _ckpt_.every = colon ? strtol(colon + 1, NULL, BASE) : 100000; CHECK(len > 0 && _ckpt_.every > 0);
+    _ckpt_.file = malloc(len + 1);                                  CHECK(_ckpt_.file);
+    _ckpt_.temp = malloc(len + 5);                                  CHECK(_ckpt_.temp);
+    sprintf(_ckpt_.file, "%.*s", (int)len, env);
+    sprintf(_ckpt_.temp, "%s.new", _ckpt_.file);
+    size_t size;
+    FILE *h = open_memstream(&_ckpt_.header, &size); CHECK(h);
+    const char *name = strrchr(argv[0], '/');
+    fprintf(h, "#!tsm-checkpoint 1\nmodel %s\nargs", name ? name + 1 : argv[0]);
+    for (int i = 1; i < argc; i++) fprintf(h, " %s", argv[i]);
+    fprintf(h, "\nreal %zu %d\nend\n", sizeof (real), REAL_MANT_DIG);
+    CHECK(!fclose(h));
+    FILE *f = fopen(_ckpt_.file, "rb");
+    _ckpt_.resume = f;
+    if (f) fclose(f);
+}
+
+static void _catch_ (int s) {
+    _signal_ = s;
+}
+
+void ckpt_resume (controls *c, int n, const block *b) {
+    c->step = 0;
+    c->t = RL(0.0);
+    if (!_ckpt_.file) return;
+    signal(SIGTERM, _catch_);
+    signal(SIGINT, _catch_);
+    if (!_ckpt_.resume) {  // the starting point, so that output from a run killed before its first checkpoint is dropped
+        ckpt_save(c, n, b);
+        return;
+    }
+    FILE *f = fopen(_ckpt_.file, "rb"); CHECK(f);
+    size_t len = strlen(_ckpt_.header);
+    char *header = malloc(len); CHECK(header);
+    CHECK(fread(header, 1, len, f) == len && !memcmp(header, _ckpt_.header, len));  // same model, command and real
+    long offset;
+    CHECK(fread(&c->step, sizeof (long), 1, f) == 1 && fread(&c->t, sizeof (real), 1, f) == 1 && fread(&offset, sizeof (long), 1, f) == 1);
+    for (int i = 0; i < n; i++) CHECK(fread(b[i].data, 1, b[i].bytes, f) == b[i].bytes);
+    CHECK(fgetc(f) == EOF && c->step >= 0 && c->step <= c->steps);
+    fclose(f);
+    free(header);
+    struct stat s;
+    CHECK(!fflush(stdout));
+    if (offset >= 0 && !fstat(fileno(stdout), &s) && S_ISREG(s.st_mode) && s.st_size > offset) {  // repeated below
+        CHECK(!ftruncate(fileno(stdout), offset) && !fseek(stdout, offset, SEEK_SET));
+    }
+    fprintf(stderr, "%sresume %s%s%s at step %s%ld%s\n", GRY, CYN, _ckpt_.file, GRY, CYN, c->step, NRM);
+}
+
+bool ckpt_due (const controls *c) {
+    return _ckpt_.file && (_signal_ || c->step == c->steps || (c->step && c->step % _ckpt_.every == 0));
+}
+
+void ckpt_save (const controls *c, int n, const block *b) {
+    CHECK(!fflush(stdout));
+    long offset = ftell(stdout);  // -1 for a pipe or terminal
+    FILE *f = fopen(_ckpt_.temp, "wb"); CHECK(f);
+    CHECK(fputs(_ckpt_.header, f) >= 0);
+    CHECK(fwrite(&c->step, sizeof (long), 1, f) == 1 && fwrite(&c->t, sizeof (real), 1, f) == 1 && fwrite(&offset, sizeof (long), 1, f) == 1);
+    for (int i = 0; i < n; i++) CHECK(fwrite(b[i].data, 1, b[i].bytes, f) == b[i].bytes);
+    CHECK(!fflush(f) && !fsync(fileno(f)) && !fclose(f));
+    CHECK(!rename(_ckpt_.temp, _ckpt_.file));  // the old checkpoint stays whole until the new one is
+    if (_signal_) {
+        fprintf(stderr, "%scheckpoint %s%s%s at step %s%ld%s\n", GRY, CYN, _ckpt_.file, GRY, CYN, c->step, NRM);
+        exit(128 + _signal_);
+    }
+}
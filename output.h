@@ -0,0 +1,66 @@
+/*
+ * Trajectory output selection, binary records and checkpoints, shared by the TSM and symplectic integrators
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#pragma once
+#include "real.h"
+
+/*
+ * Parses the first command argument, "<dp>[:<stride>]" for text or "b[:<stride>]" for binary records
+ */
+void out_get_c (controls *c, const char *arg);
+
+/*
+ * True if the current step (c->step) is to be output, i.e. on the stride or at the end
+ */
+bool out_due (const controls *c);
+
+/*
+ * Text of a real, "%<flags>.<dp>e", or exactly in hex ("%<flags>a") if dp is 0, at the full precision of real
+ * (quadmath_snprintf for __float128); flags is "+", " " or "", s holds OUT_REAL chars and is returned
+ */
+#define OUT_REAL 128
+char *out_real (char *s, const char *flags, int dp, real r);
+
+/*
+ * Writes the self-describing text header for binary records (does nothing for text output), columns is space separated
+ */
+void out_header (const controls *c, int argc, char **argv, const char *columns);
+
+/*
+ * Writes a single binary record of n reals
+ */
+void out_record (const real *r, int n);
+
+/*
+ * A block of integrator or model state, written to checkpoints as raw bytes
+ */
+typedef struct Block {
+    void *data;
+    size_t bytes;
+} block;
+
+/*
+ * Checkpoint/restart, enabled by CHECKPOINT=<file>[:<every>] in the environment (every 100000 steps by default);
+ * call before out_header(), which writes nothing when resuming, so that output appended (>>) to the same file continues
+ * as a single stream
+ */
+void ckpt_init (int argc, char **argv);
+
+/*
+ * Restores c->step, c->t and the n blocks from an existing checkpoint (or zeroes c->step and c->t and writes one if
+ * there is none), after checking that it was written by the same command; stdout, if a file, is cut back to its length at the time
+ * of the checkpoint.  From here on SIGTERM and SIGINT write a checkpoint at the end of the current step, then exit
+ */
+void ckpt_resume (controls *c, int n, const block *b);
+
+/*
+ * True if a checkpoint is due, at the start of every "every"'th step, at the end of the run, or after a signal
+ */
+bool ckpt_due (const controls *c);
+
+/*
+ * Writes the step, time and n blocks to a new file, then renames it over the old checkpoint; exits after a signal
+ */
+void ckpt_save (const controls *c, int n, const block *b);
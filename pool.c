@@ -0,0 +1,60 @@
+/*
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "real.h"
+#include "pool.h"
+
+typedef struct Pool {
+    int next, last;
+    pool_start start;
+    pool_work work;
+    pool_stop stop;
+    void *arg;
+    pthread_mutex_t lock;
+} pool;
+
+typedef struct Thread {
+    pool *p;
+    int id;
+    pthread_t t;
+} thread;
+
+static void *_thread_ (void *arg) {
+    const thread *t = arg;
+    pool *p = t->p;
+    void *local = p->start ? p->start(p->arg, t->id) : NULL;
+    while (true) {
+        pthread_mutex_lock(&p->lock);
+        int i = p->next++;
+        pthread_mutex_unlock(&p->lock);
+        if (i >= p->last) break;
+        p->work(p->arg, local, i);
+    }
+    if (p->stop) p->stop(p->arg, local);
+    return NULL;
+}
+
+int pool_threads (int items) {
+    int _ = (int)sysconf(_SC_NPROCESSORS_ONLN); CHECK(_ > 0);
+    return items < 1 ? 1 : _ < items ? _ : items;
+}
+
+int pool_run (int first, int last, pool_start start, pool_work work, pool_stop stop, void *arg) {
+    pool p = {.next = first, .last = last, .start = start, .work = work, .stop = stop, .arg = arg};
+    CHECK(!pthread_mutex_init(&p.lock, NULL));
+    int n = pool_threads(last - first);
+    thread *t = malloc((size_t)n * sizeof (thread)); CHECK(t);
+    for (int i = 0; i < n; i++) {
+        t[i] = (thread){.p = &p, .id = i};
+        CHECK(!pthread_create(&t[i].t, NULL, _thread_, &t[i]));
+    }
+    for (int i = 0; i < n; i++) pthread_join(t[i].t, NULL);
+    pthread_mutex_destroy(&p.lock);
+    free(t);
+    return n;
+}
@@ -0,0 +1,32 @@
+/*
+ * Work sharing for the multi-threaded drivers, independent items taken in turn by one thread per core
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#pragma once
+
+/*
+ * Thread state, made by each thread before its first item (arg is the driver's, thread counts from 0)
+ */
+typedef void *(*pool_start)(void *arg, int thread);
+
+/*
+ * Does item i, with the thread state (NULL if there is no pool_start)
+ */
+typedef void (*pool_work)(void *arg, void *worker, int i);
+
+/*
+ * Releases the thread state, after its last item
+ */
+typedef void (*pool_stop)(void *arg, void *worker);
+
+/*
+ * Number of threads for a given number of items, one per core but no more than the items (at least 1)
+ */
+int pool_threads (int items);
+
+/*
+ * Shares items first to last - 1 out in that order, start & stop may be NULL; returns when all are done, with the
+ * number of threads used (pool_threads(last - first))
+ */
+int pool_run (int first, int last, pool_start start, pool_work work, pool_stop stop, void *arg);
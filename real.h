@@ -47,9 +47,64 @@
 } while (0)
 
 /*
- * Main floating point type
+ * Main floating point type, selected at build time (default long double, -DREAL_F64 double, -DREAL_F128 __float128),
+ * together with matching literals RL(x), maths functions, string conversion, significand width and epsilon.
+ * Values are written through out_real() (output.h) at full precision; incidental text (times, thresholds) goes through
+ * long double, so "%Le" formats are common to all three.
  */
+#if defined(REAL_F64)
+#include <float.h>
+typedef double real;
+#define REAL_MANT_DIG DBL_MANT_DIG
+#define REAL_EPSILON DBL_EPSILON
+#define RL(x) x
+#define FN(f) f
+#define HUGE_VALR HUGE_VAL
+#define STRTOR strtod
+#elif defined(REAL_F128)
+#include <quadmath.h>
+__extension__ typedef __float128 real;
+#define REAL_MANT_DIG FLT128_MANT_DIG
+#define REAL_EPSILON (__extension__ FLT128_EPSILON)
+#define RL(x) (__extension__ x##Q)
+#define FN(f) f##q
+#define HUGE_VALR HUGE_VALQ
+#define STRTOR strtoflt128
+#else
+#include <float.h>
 typedef long double real;
+#define REAL_MANT_DIG LDBL_MANT_DIG
+#define REAL_EPSILON LDBL_EPSILON
+#define RL(x) x##L
+#define FN(f) f##l
+#define HUGE_VALR HUGE_VALL
+#define STRTOR strtold
+#endif
+
+#define SQRT(x) FN(sqrt)(x)
+#define CBRT(x) FN(cbrt)(x)
+#define POW(x, y) FN(pow)(x, y)
+#define EXP(x) FN(exp)(x)
+#define LOG(x) FN(log)(x)
+#define LOG10(x) FN(log10)(x)
+#define SIN(x) FN(sin)(x)
+#define COS(x) FN(cos)(x)
+#define TAN(x) FN(tan)(x)
+#define SINH(x) FN(sinh)(x)
+#define COSH(x) FN(cosh)(x)
+#define TANH(x) FN(tanh)(x)
+#define ASIN(x) FN(asin)(x)
+#define ACOS(x) FN(acos)(x)
+#define ATAN(x) FN(atan)(x)
+#define ASINH(x) FN(asinh)(x)
+#define ACOSH(x) FN(acosh)(x)
+#define ATANH(x) FN(atanh)(x)
+#define FABS(x) FN(fabs)(x)
+#define FMA(x, y, z) FN(fma)(x, y, z)
+#define FMOD(x, y) FN(fmod)(x, y)
+#define FMIN(x, y) FN(fmin)(x, y)
+#define FMAX(x, y) FN(fmax)(x, y)
+#define CEIL(x) FN(ceil)(x)
 
 /*
  * Client model data
@@ -64,7 +119,7 @@ typedef struct pair_l {
 } pair;
 
 /*
- * Triple of long doubles, by coordinate
+ * Triple of reals, by coordinate
  */
 typedef struct triple_l {
     real x, y, z;
@@ -75,6 +130,9 @@ typedef struct triple_l {
  */
 typedef struct Controls {
     bool looping;         // generators only
-    int order, step, steps, dp;
+    bool binary;          // binary records instead of text, see output.h
+    int order, dp, stride;
+    long step, steps;     // 64 bit, for runs of 10^9 steps and beyond
     real h;
+    real tol, t;          // TSM only, variable step if tol > 0, t is the time of the current step
 } controls;
@@ -0,0 +1,76 @@
+/*
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "taylor-ode.h"
+#include "registry.h"
+
+#define MODELS(_) _(bouali, "bouali", 4) _(burke_shaw, "burke-shaw", 2) _(genesio_tesi, "genesio-tesi", 2) \
+    _(halvorsen, "halvorsen", 1) _(isuc, "isuc", 3) _(lorenz, "lorenz", 4) _(rf, "rf", 2) _(rossler, "rossler", 3) \
+    _(rucklidge, "rucklidge", 2) _(thomas, "thomas", 1) _(wimol_banlue, "wimol-banlue", 1) _(yu_wang, "yu-wang", 4)
+
+#define DECLARE(m, name, parameters) \
+    model *m##_init_p (int argc, char **argv, int order); \
+    triplet m##_ode (series X, series Y, series Z, const model *p, const int k); \
+    triplet m##_tangent (series DX, series DY, series DZ, series X, series Y, series Z, const model *p, const int k); \
+    triplet m##_ode_p (series X, series Y, series Z, const model *p, const int i, const int k); \
+    void m##_ode_e (series VX, series VY, series VZ, const ensemble *e, const model *p, const int k);
+MODELS(DECLARE)
+
+typedef struct Client {
+    const char *name;
+    int parameters;  // model arguments after the controls & coordinates, as checked by its tsm_init_p()
+    model *(*init_p) (int argc, char **argv, int order);
+    triplet (*ode) (series X, series Y, series Z, const model *p, const int k);
+    triplet (*tangent) (series DX, series DY, series DZ, series X, series Y, series Z, const model *p, const int k);
+    triplet (*ode_p) (series X, series Y, series Z, const model *p, const int i, const int k);
+    void (*ode_e) (series VX, series VY, series VZ, const ensemble *e, const model *p, const int k);
+} client;
+
+#define ENTRY(m, name, parameters) {name, parameters, m##_init_p, m##_ode, m##_tangent, m##_ode_p, m##_ode_e},
+static const client _clients_[] = { MODELS(ENTRY) };
+
+#define CLIENTS (int)(sizeof _clients_ / sizeof _clients_[0])
+
+static __thread const client *_current_ = NULL;  // a thread runs one model at a time
+
+static const client *_find_ (const char *name) {
+    for (int i = 0; i < CLIENTS; i++) if (!strcmp(_clients_[i].name, name)) return &_clients_[i];
+    return NULL;
+}
+
+const char *tsm_model (int i) {
+    return i >= 0 && i < CLIENTS ? _clients_[i].name : NULL;
+}
+
+bool tsm_hosted (const char *name) {
+    return _find_(name) != NULL;
+}
+
+int tsm_parameters (const char *name) {
+    const client *_ = _find_(name);
+    return _ ? _->parameters : -1;
+}
+
+model *tsm_init_p (int argc, char **argv, int order) {
+    _current_ = _find_(argv[0]); CHECK(_current_);
+    return _current_->init_p(argc, argv, order);
+}
+
+triplet ode (series x, series y, series z, const model *p, const int k) {
+    return _current_->ode(x, y, z, p, k);
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *p, const int k) {
+    return _current_->tangent(dx, dy, dz, x, y, z, p, k);
+}
+
+triplet ode_p (series x, series y, series z, const model *p, const int i, const int k) {
+    return _current_->ode_p(x, y, z, p, i, k);
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *p, const int k) {
+    _current_->ode_e(vx, vy, vz, e, p, k);
+}
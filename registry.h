@@ -0,0 +1,24 @@
+/*
+ * Model registry, for the multi-model binary (tsm); every tsm-*.c is compiled again with its client functions renamed
+ * (lorenz_ode() and so on, - becoming _), and the obligatory client functions in registry.c pass each call on to the
+ * model chosen by the last tsm_init_p() in the same thread, which takes the model name from argv[0]
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#pragma once
+#include <stdbool.h>
+
+/*
+ * Name of the ith registered model (e.g. lorenz, burke-shaw), or NULL past the end
+ */
+const char *tsm_model (int i);
+
+/*
+ * True if name is a registered model
+ */
+bool tsm_hosted (const char *name);
+
+/*
+ * Number of parameters a registered model takes after the controls & coordinates (argc is 8 more), or -1 if not registered
+ */
+int tsm_parameters (const char *name);
@@ -3,22 +3,37 @@
  *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
+#define _POSIX_C_SOURCE 200809L  // clock_gettime()
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include "symplectic.h"
+#include "instrument.h"
+
+#ifdef INSTRUMENT  // make INSTRUMENT=on
+enum { P_UPDATE_Q, P_UPDATE_P, P_OUTPUT, PROBES };
+
+static probe _probes_[PROBES] = {[P_UPDATE_Q] = {.name = "update_q"}, [P_UPDATE_P] = {.name = "update_p"}, [P_OUTPUT] = {.name = "output"}};
+
+static void _report_ (void) {
+    probe_report(_probes_, PROBES);
+}
+#endif
 
 real error (real e) {
-    return - log10l(fabsl(e) >= 1e-36L ? fabsl(e) : 1e-36L);
+    return - LOG10(FABS(e) >= RL(1e-36) ? FABS(e) : RL(1e-36));
 }
 
 controls *symp_get_c (int argc, char **argv) {
     PRINT_ARGS(argc, argv);
+#ifdef INSTRUMENT
+    atexit(_report_);
+#endif
     controls *_ = malloc(sizeof (controls)); CHECK(_);
-    _->dp = (int)strtol(argv[1], NULL, BASE);    CHECK(_->dp >= 1);
+    out_get_c(_, argv[1]);                       CHECK(_->binary || _->dp >= 1);
     _->order = (int)strtol(argv[2], NULL, BASE); CHECK(_->order > 0 && _->order % 2 == 0);
-    _->h = strtold(argv[3], NULL);               CHECK(_->h > 0.0L);
-    _->steps = (int)strtol(argv[4], NULL, BASE); CHECK(_->steps >= 0 && _->steps <= 1000000);
+    _->h = STRTOR(argv[3], NULL);               CHECK(_->h > RL(0.0));
+    _->steps = strtol(argv[4], NULL, BASE);      CHECK(_->steps >= 0);
     _->looping = false;
     return _;
 }
@@ -26,23 +41,26 @@ controls *symp_get_c (int argc, char **argv) {
 static void _symplectic_ (int order, model *p, real c_d) {
     if (order > 2) {
         order -= 2;
-        real fwd = 1.0L / (4.0L - powl(4.0L, 1.0L / (order + 1)));
+        real fwd = RL(1.0) / (RL(4.0) - POW(RL(4.0), RL(1.0) / (order + 1)));
         for (int stage = 0; stage < 5; stage++) {
-            _symplectic_(order, p, (stage == 2 ? 1.0L - 4.0L * fwd : fwd) * c_d);
+            _symplectic_(order, p, (stage == 2 ? RL(1.0) - RL(4.0) * fwd : fwd) * c_d);
         }
     } else {
-        update_q(p, c_d * 0.5L);
-        update_p(p, c_d);
-        update_q(p, c_d * 0.5L);
+        TIME(P_UPDATE_Q, update_q(p, c_d * RL(0.5)));
+        TIME(P_UPDATE_P, update_p(p, c_d));
+        TIME(P_UPDATE_Q, update_q(p, c_d * RL(0.5)));
     }
 }
 
 void solve (controls *c, model *p, plotter output) {
-    for (int step = 0; step < c->steps; step++) {
-        output(c->dp, p, step * c->h);
+    block b = symp_state(p);
+    for (ckpt_resume(c, 1, &b); c->step < c->steps; c->step++) {
+        if (ckpt_due(c)) ckpt_save(c, 1, &b);
+        TIME(P_OUTPUT, output(c, p, (real)c->step * c->h));
         _symplectic_(c->order, p, c->h);
     }
-    output(c->dp, p, c->steps * c->h);
+    if (ckpt_due(c)) ckpt_save(c, 1, &b);
+    TIME(P_OUTPUT, output(c, p, (real)c->steps * c->h));
 }
 
 bool generate (controls *c, model *p) {
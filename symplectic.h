@@ -3,6 +3,7 @@
  */
 #pragma once
 #include "real.h"
+#include "output.h"
 
 /*
  * Retrieves integrator control parameters
@@ -20,9 +21,14 @@ model *symp_init_p (int argc, char **argv);
 real error (real e);
 
 /*
- * To pass a plotter as parameter
+ * Client output callback, called at every step; clients only write output when out_due(c)
  */
-typedef void (*plotter)(int dp, model *p, real t);
+typedef void (*plotter)(const controls *c, model *p, real t);
+
+/*
+ * Client checkpoint state, the block of model memory that changes during a run (pointers excluded)
+ */
+block symp_state (model *p);
 
 /*
  * Coordinate updater dq = (dH/dp).dt
@@ -3,55 +3,161 @@
  *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
+#define _POSIX_C_SOURCE 200809L  // clock_gettime()
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include <ctype.h>
 #include <math.h>
 #include "taylor-ode.h"
+#include "output.h"
+#include "instrument.h"
+#if defined(TSM_N) || defined(TSM_RELAXED)
+#include <pthread.h>
+#endif
+
+#ifdef TSM_UNROLL  // order-specialised kernels (make KERNELS=unrolled), UNROLL only where o is then a constant
+#define UNROLL _Pragma("GCC unroll 64")
+#define SPECIALISE(o, kernel) switch (o) {  /* not 4 to 10 or 20, where Thomas is slower */ \
+    case 12: kernel(12); return; case 16: kernel(16); return; case 24: kernel(24); return; case 32: kernel(32); return; \
+}
+#else
+#define UNROLL
+#define SPECIALISE(o, kernel)
+#endif
+
+#ifdef TSM_RELAXED  // relaxed products keep partial sums in storage for each step (see below), products are direct outside steps
+static int _relaxed_from_;
+static void _open_ (int o);
+static void _restart_ (void);
+static void _skip_ (int n);
+static void _close_ (void);
+#define OPEN_STEP(o) _open_(o)
+#define NEXT_K() _restart_()
+#define SKIP(n) _skip_(n)
+#define CLOSE_STEP() _close_()
+#else
+#define OPEN_STEP(o)
+#define NEXT_K()
+#define SKIP(n)
+#define CLOSE_STEP()
+#endif
+
+#ifdef INSTRUMENT  // make INSTRUMENT=on, the t_*() loops are the sum of k over their calls, as their work is O(k)
+enum { P_CAUCHY, P_CHAIN, P_CONST, P_ABS, P_MUL, P_DIV, P_SQR, P_SQRT, P_PWR, P_EXP, P_LN, P_SIN_COS, P_TAN_SEC2,
+       P_ASIN_COS, P_ACOS_SIN, P_ATAN_SEC2, P_DIFF, P_NEXT, P_OUT, PROBES };
+
+static probe _probes_[PROBES] = {
+    [P_CAUCHY] = {.name = "_cauchy_"}, [P_CHAIN] = {.name = "_chain_"}, [P_CONST] = {.name = "t_const"},
+    [P_ABS] = {.name = "t_abs"}, [P_MUL] = {.name = "t_mul"}, [P_DIV] = {.name = "t_div"}, [P_SQR] = {.name = "t_sqr"},
+    [P_SQRT] = {.name = "t_sqrt"}, [P_PWR] = {.name = "t_pwr"}, [P_EXP] = {.name = "t_exp"}, [P_LN] = {.name = "t_ln"},
+    [P_SIN_COS] = {.name = "t_sin_cos"}, [P_TAN_SEC2] = {.name = "t_tan_sec2"}, [P_ASIN_COS] = {.name = "t_asin_cos"},
+    [P_ACOS_SIN] = {.name = "t_acos_sin"}, [P_ATAN_SEC2] = {.name = "t_atan_sec2"},
+    [P_DIFF] = {.name = "_diff_"}, [P_NEXT] = {.name = "_next_"}, [P_OUT] = {.name = "_out_"}
+};
+
+static void _report_ (void) {
+    probe_report(_probes_, PROBES);
+}
+#endif
+
+#define LINE 64  // cache line, also enough for any SIMD width in use
+
+static size_t _line_ (size_t bytes) {
+    return (bytes + LINE - 1) / LINE * LINE;
+}
+
+static arena _arena_ (size_t bytes) {
+    void *_ = NULL;
+    CHECK(bytes > 0 && !posix_memalign(&_, LINE, bytes));
+    return (arena){_, (char *)_ + bytes};
+}
 
 controls *tsm_get_c (int argc, char **argv) {
     PRINT_ARGS(argc, argv);
+    return tsm_read_c(argv);
+}
+
+controls *tsm_read_c (char **argv) {
+#ifdef INSTRUMENT
+    static bool registered = false;
+    if (!registered) atexit(_report_);
+    registered = true;
+#endif
+#ifdef TSM_RELAXED
+    const char *from = getenv("RELAXED");  // read before any threads start
+    if (from) _relaxed_from_ = (int)strtol(from, NULL, BASE);
+#endif
     controls *_ = malloc(sizeof (controls)); CHECK(_);
-    _->dp = (int)strtol(argv[1], NULL, BASE);    CHECK(_->dp >= 0);
-    _->order = (int)strtol(argv[2], NULL, BASE); CHECK(_->order >= 2 && _->order <= 64);
-    _->h = strtold(argv[3], NULL);               CHECK(_->h > 0.0L);
-    _->steps = (int)strtol(argv[4], NULL, BASE); CHECK(_->steps >= 0 && _->steps <= 1000000);
+    out_get_c(_, argv[1]);                       CHECK(_->dp >= 0);
+    _->order = (int)strtol(argv[2], NULL, BASE);
+    _->h = STRTOR(argv[3], NULL);               CHECK(_->h != RL(0.0));
+    _->tol = _->h < RL(0.0) ? - _->h : RL(0.0);        CHECK(_->tol < RL(1.0));
+    if (!_->order && _->tol > RL(0.0)) _->order = (int)CEIL(RL(1.0) - RL(0.5) * LOG(_->tol));  // Jorba & Zou
+    CHECK(_->order >= 2 && _->order <= ORDER_MAX);
+    _->steps = strtol(argv[4], NULL, BASE);      CHECK(_->steps >= 0);
     _->looping = false;
     return _;
 }
 
 xyz *tsm_init (char **argv, int o) {
-    xyz *_ = malloc(sizeof (xyz)); CHECK(_);
-    _->x = tsm_jet(o + 1); _->x[0] = strtold(argv[5], NULL);
-    _->y = tsm_jet(o + 1); _->y[0] = strtold(argv[6], NULL);
-    _->z = tsm_jet(o + 1); _->z[0] = strtold(argv[7], NULL);
+    arena a = tsm_arena(sizeof (xyz), 3, o + 1);
+    xyz *_ = tsm_take(&a, sizeof (xyz));
+    _->x = tsm_arena_jet(&a, o + 1); _->x[0] = STRTOR(argv[5], NULL);
+    _->y = tsm_arena_jet(&a, o + 1); _->y[0] = STRTOR(argv[6], NULL);
+    _->z = tsm_arena_jet(&a, o + 1); _->z[0] = STRTOR(argv[7], NULL);
     return _;
 }
 
 void tsm_get_p (char **argv, int argc, ...) {
     va_list _;
     va_start(_, argc);
-    for (int i = 8; i < argc; i++) *va_arg(_, real *) = strtold(argv[i], NULL);
+    for (int i = 8; i < argc; i++) *va_arg(_, real *) = STRTOR(argv[i], NULL);
     va_end(_);
 }
 
 series tsm_jet (int n) {
+    arena a = tsm_arena(0, 1, n);
+    return tsm_arena_jet(&a, n);
+}
+
+arena tsm_arena (size_t head, int jets, int n) {
+    CHECK(jets >= 0 && n > 0);
+    return _arena_(_line_(head) + (size_t)jets * _line_((size_t)n * sizeof (real)));
+}
+
+void *tsm_take (arena *a, size_t bytes) {
+    bytes = _line_(bytes);
+    CHECK(bytes <= (size_t)(a->end - a->next));
+    void *_ = a->next;
+    a->next += bytes;
+    return memset(_, 0, bytes);
+}
+
+series tsm_arena_jet (arena *a, int n) {
     CHECK(n > 0);
-    series _ = malloc((size_t)n * sizeof (real)); CHECK(_);
-    for (int i = 0; i < n; i++) _[i] = 0.0L;
+    series _ = tsm_take(a, (size_t)n * sizeof (real));
+    for (int i = 0; i < n; i++) _[i] = RL(0.0);
     return _;
 }
 
-real horner (const series u, int o, real h) {
-    real _ = 0.0L;
-    for (int i = o; i >= 0; i--) _ = _ * h + u[i];
+static inline real _horner_ (const series u, int o, real h) {
+    real _ = RL(0.0);
+    UNROLL for (int i = o; i >= 0; i--) _ = _ * h + u[i];
     CHECK(isfinite(_));
     return _;
 }
 
-static void _diff_ (xyz *_, const model *p, int o) {
-    for (int k = 0; k < o; k++) {
+real horner (const series u, int o, real h) {
+    return _horner_(u, o, h);
+}
+
+#ifndef TSM_N  // the 3-D engine (client ode(), tangent() and ode_e()), the N-variable one (client ode_n()) is below
+
+static inline void _diff_o_ (xyz *_, const model *p, int o) {
+    UNROLL for (int k = 0; k < o; k++) {
+        NEXT_K();
         triplet v = ode(_->x, _->y, _->z, p, k);
         _->x[k + 1] = v.x / (k + 1);
         _->y[k + 1] = v.y / (k + 1);
@@ -59,149 +165,1123 @@ static void _diff_ (xyz *_, const model *p, int o) {
     }
 }
 
+#define DIFF(n) _diff_o_(_, p, n)
+static void _diff_any_ (xyz *_, const model *p, int o) {
+    SPECIALISE(o, DIFF)
+    _diff_o_(_, p, o);
+}
+
+static void _diff_ (xyz *_, const model *p, int o) {
+    OPEN_STEP(o);
+    TIME(P_DIFF, _diff_any_(_, p, o));
+    CLOSE_STEP();
+}
+
+static inline void _next_o_ (xyz *_, int o, real h) {
+    _->x[0] = _horner_(_->x, o, h);
+    _->y[0] = _horner_(_->y, o, h);
+    _->z[0] = _horner_(_->z, o, h);
+}
+
+#define NEXT(n) _next_o_(_, n, h)
+static void _next_any_ (xyz *_, int o, real h) {
+    SPECIALISE(o, NEXT)
+    _next_o_(_, o, h);
+}
+
 static void _next_ (xyz *_, int o, real h) {
-    _->x[0] = horner(_->x, o, h);
-    _->y[0] = horner(_->y, o, h);
-    _->z[0] = horner(_->z, o, h);
+    TIME(P_NEXT, _next_any_(_, o, h));
+}
+
+static real _norm_ (const xyz *_, int k) {
+    return FMAX(FABS(_->x[k]), FMAX(FABS(_->y[k]), FABS(_->z[k])));
+}
+
+static real _step_size_ (const xyz *_, int o, real tol) {  // Jorba & Zou, from the last two coefficients
+    real h = HUGE_VALR;
+    for (int k = o - 1; k <= o; k++) {
+        real norm = _norm_(_, k);
+        if (norm > RL(0.0)) h = FMIN(h, POW(tol / norm, RL(1.0) / k));
+    }
+    return isfinite(h) ? h : RL(1.0);  // terminating series, any step is exact
+}
+
+static real _h_ (const xyz *_, const controls *c) {
+    return c->tol > RL(0.0) ? _step_size_(_, c->order, c->tol) : c->h;
+}
+
+static real _advance_ (xyz *_, controls *c, long step) {
+    real h = _h_(_, c);
+    _next_(_, c->order, h);
+    c->t = c->tol > RL(0.0) ? c->t + h : c->h * (real)(step + 1);
+    return h;
 }
 
 bool tsm_gen (controls *c, xyz *_, const model *p) {
     if (c->looping) goto resume; else c->looping = true;
+    c->t = RL(0.0);
     for (c->step = 0; c->step < c->steps; c->step++) {
         _diff_(_, p, c->order);
-        _next_(_, c->order, c->h);
+        _advance_(_, c, c->step);
         return true;
         resume: ;
     }
     return c->looping = false;
 }
 
-static void _out_ (int dp, real x, real y, real z, real t, char x_tag, char y_tag, char z_tag, clock_t since) {
-    real cpu = (real)(clock() - since) / CLOCKS_PER_SEC;
-    if (dp) {
-        printf("%+.*Le %+.*Le %+.*Le %.6Le %c %c %c %.3Lf\n", dp, x, dp, y, dp, z, t, x_tag, y_tag, z_tag, cpu);
-    } else {
-        printf("%+La %+La %+La %.6Le %c %c %c %.3Lf\n", x, y, z, t, x_tag, y_tag, z_tag, cpu);
+static void _write_ (const controls *c, real x, real y, real z, real t, char x_tag, char y_tag, char z_tag, clock_t since) {
+    if (c->binary) {
+        out_record((real []){x, y, z, t}, 4);
+        return;
     }
+    char sx[OUT_REAL], sy[OUT_REAL], sz[OUT_REAL];
+    printf("%s %s %s %.6Le %c %c %c %.3Lf\n", out_real(sx, "+", c->dp, x), out_real(sy, "+", c->dp, y), out_real(sz, "+", c->dp, z),
+           (long double)t, x_tag, y_tag, z_tag, (long double)(clock() - since) / CLOCKS_PER_SEC);
+}
+
+static void _out_ (const controls *c, real x, real y, real z, real t, char x_tag, char y_tag, char z_tag, clock_t since) {
+    TIME(P_OUT, _write_(c, x, y, z, t, x_tag, y_tag, z_tag, since));
 }
 
 static char _tp_ (series u, real *v_old, char min) {
-    char tag = *v_old * u[1] >= 0.0L ? '_' : (u[2] > 0.0L ? min : (char)toupper(min));
+    char tag = *v_old * u[1] >= RL(0.0) ? '_' : (u[2] > RL(0.0) ? min : (char)toupper(min));
     *v_old = u[1];
     return tag;
 }
 
 void tsm (controls *c, xyz *_, const model *p, clock_t t0) {
-    real vX = 0.0L, vY = 0.0L, vZ = 0.0L;
-    for (int step = 0; step < c->steps; step++) {
+    real v[3] = {RL(0.0), RL(0.0), RL(0.0)};
+    size_t jet = (size_t)(c->order + 1) * sizeof (real);  // model jets are all derived from these at every step
+    block b[] = {{_->x, jet}, {_->y, jet}, {_->z, jet}, {v, sizeof v}};
+    for (ckpt_resume(c, 4, b); c->step < c->steps; c->step++) {
+        if (ckpt_due(c)) ckpt_save(c, 4, b);
+        _diff_(_, p, c->order);
+        char x_tag = _tp_(_->x, v, 'x'), y_tag = _tp_(_->y, v + 1, 'y'), z_tag = _tp_(_->z, v + 2, 'z');
+        if (out_due(c)) _out_(c, _->x[0], _->y[0], _->z[0], c->t, x_tag, y_tag, z_tag, t0);
+        _advance_(_, c, c->step);
+    }
+    if (ckpt_due(c)) ckpt_save(c, 4, b);
+    _out_(c, _->x[0], _->y[0], _->z[0], c->t, '_', '_', '_', t0);
+}
+
+static bool _finite_ (const xyz *_, int o) {
+    for (int k = 0; k <= o; k++) if (!isfinite(_->x[k]) || !isfinite(_->y[k]) || !isfinite(_->z[k])) return false;
+    return true;
+}
+
+bool tsm_tp (controls *c, xyz *_, const model *p, int samples, turning **tp, int *n) {
+    real vX = RL(0.0), vY = RL(0.0), vZ = RL(0.0);
+    int size = 64;
+    *tp = malloc((size_t)size * sizeof (turning)); CHECK(*tp);
+    *n = 0;
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_(_, p, c->order);
+        if (!_finite_(_, c->order)) {
+            free(*tp);
+            *tp = NULL;
+            *n = 0;
+            return false;
+        }
+        real u[] = {_->x[0], _->y[0], _->z[0]};
+        char tags[] = {_tp_(_->x, &vX, 'x'), _tp_(_->y, &vY, 'y'), _tp_(_->z, &vZ, 'z')};
+        if (c->step > c->steps - samples) {
+            for (int i = 0; i < 3; i++) {
+                if (tags[i] == '_') continue;
+                if (*n == size) {
+                    size *= 2;
+                    *tp = realloc(*tp, (size_t)size * sizeof (turning)); CHECK(*tp);
+                }
+                (*tp)[(*n)++] = (turning){.value = u[i], .tag = tags[i]};
+            }
+        }
+        _advance_(_, c, c->step);
+    }
+    return true;
+}
+
+int tsm_cns (controls *c, xyz *_, const model *p, controls *r, xyz *ref, const model *q, int substeps, const real *threshold, int n) {
+    CHECK(c->tol == RL(0.0) && r->tol == RL(0.0) && substeps > 0);
+    for (int i = 1; i < n; i++) CHECK(threshold[i] > threshold[i - 1]);
+    clock_t cpu = 0;
+    int exceeded = 0;
+    c->t = r->t = RL(0.0);
+    r->step = 0;
+    for (c->step = 0; c->step <= c->steps; c->step++) {
+        real d = SQRT(SQR(_->x[0] - ref->x[0]) + SQR(_->y[0] - ref->y[0]) + SQR(_->z[0] - ref->z[0]));
+        for (; exceeded < n && d > threshold[exceeded]; exceeded++) {
+            printf("%s %.1Le  %s %6.3Lf  %s %.3Lf\n", "threshold:", (long double)threshold[exceeded],
+                   "t:", (long double)c->t, "cpu:", (long double)cpu / CLOCKS_PER_SEC);
+        }
+        if (exceeded == n || c->step == c->steps) break;
+        clock_t t0 = clock();
+        _diff_(_, p, c->order);
+        _advance_(_, c, c->step);
+        cpu += clock() - t0;
+        for (int s = 0; s < substeps; s++, r->step++) {
+            _diff_(ref, q, r->order);
+            _advance_(ref, r, r->step);
+        }
+    }
+    return exceeded;
+}
+
+triplet *tsm_path (controls *r, xyz *ref, const model *q, int substeps, long steps) {
+    CHECK(r->tol == RL(0.0) && substeps > 0);
+    triplet *_ = malloc((size_t)(steps + 1) * sizeof (triplet)); CHECK(_);
+    r->t = RL(0.0);
+    r->step = 0;
+    for (long step = 0; step <= steps; step++) {
+        _[step] = (triplet){ref->x[0], ref->y[0], ref->z[0]};
+        if (step == steps) break;
+        for (int s = 0; s < substeps; s++, r->step++) {
+            _diff_(ref, q, r->order);
+            _advance_(ref, r, r->step);
+        }
+    }
+    return _;
+}
+
+void tsm_span (controls *c, xyz *_, const model *p, triplet *s, triplet *path) {
+    CHECK(c->tol == RL(0.0));
+    _->x[0] = s->x;
+    _->y[0] = s->y;
+    _->z[0] = s->z;
+    c->t = RL(0.0);
+    for (c->step = 0; c->step <= c->steps; c->step++) {
+        if (path && c->step % c->stride == 0) path[c->step / c->stride] = (triplet){_->x[0], _->y[0], _->z[0]};
+        if (c->step == c->steps) break;
+        _diff_(_, p, c->order);
+        _advance_(_, c, c->step);
+    }
+    *s = (triplet){_->x[0], _->y[0], _->z[0]};
+}
+
+real tsm_thread_cpu (void) {
+    struct timespec _;
+    CHECK(!clock_gettime(CLOCK_THREAD_CPUTIME_ID, &_));
+    return (real)_.tv_sec + (real)_.tv_nsec * RL(1e-9);
+}
+
+int tsm_cns_path (controls *c, xyz *_, const model *p, const triplet *path, const real *threshold, int n, pair *clean) {
+    CHECK(c->tol == RL(0.0));
+    for (int i = 1; i < n; i++) CHECK(threshold[i] > threshold[i - 1]);
+    real cpu = tsm_thread_cpu();
+    int exceeded = 0;
+    c->t = RL(0.0);
+    for (c->step = 0; c->step <= c->steps; c->step++) {
+        const triplet *ref = path + c->step;
+        real d = SQRT(SQR(_->x[0] - ref->x) + SQR(_->y[0] - ref->y) + SQR(_->z[0] - ref->z));
+        for (; exceeded < n && d > threshold[exceeded]; exceeded++) clean[exceeded] = (pair){c->t, tsm_thread_cpu() - cpu};
+        if (exceeded == n || c->step == c->steps) break;
+        _diff_(_, p, c->order);
+        _advance_(_, c, c->step);
+    }
+    return exceeded;
+}
+
+tangents *lyap_init (int o) {
+    arena a = tsm_arena(sizeof (tangents), 9, o + 1);
+    tangents *_ = tsm_take(&a, sizeof (tangents));
+    for (int j = 0; j < 3; j++) {
+        _->v[j].x = tsm_arena_jet(&a, o + 1);
+        _->v[j].y = tsm_arena_jet(&a, o + 1);
+        _->v[j].z = tsm_arena_jet(&a, o + 1);
+        _->sum[j] = RL(0.0);
+    }
+    _->v[0].x[0] = _->v[1].y[0] = _->v[2].z[0] = RL(1.0);
+    return _;
+}
+
+static void _diff_v_ (xyz *_, xyz *dv, int n, const model *p, int o) {  // state & n deviation vectors
+    OPEN_STEP(o);
+    for (int k = 0; k < o; k++) {
+        NEXT_K();
+        triplet v = ode(_->x, _->y, _->z, p, k);
+        _->x[k + 1] = v.x / (k + 1);
+        _->y[k + 1] = v.y / (k + 1);
+        _->z[k + 1] = v.z / (k + 1);
+        for (int j = 0; j < n; j++) {
+            xyz *d = &dv[j];
+            triplet w = tangent(d->x, d->y, d->z, _->x, _->y, _->z, p, k);
+            d->x[k + 1] = w.x / (k + 1);
+            d->y[k + 1] = w.y / (k + 1);
+            d->z[k + 1] = w.z / (k + 1);
+        }
+    }
+    CLOSE_STEP();
+}
+
+static void _renormalise_ (tangents *t) {  // modified Gram-Schmidt, i.e. QR, on the current deviation vectors
+    for (int j = 0; j < 3; j++) {
+        xyz *u = &t->v[j];
+        for (int i = 0; i < j; i++) {
+            xyz *q = &t->v[i];
+            real dot = u->x[0] * q->x[0] + u->y[0] * q->y[0] + u->z[0] * q->z[0];
+            u->x[0] -= dot * q->x[0];
+            u->y[0] -= dot * q->y[0];
+            u->z[0] -= dot * q->z[0];
+        }
+        real norm = SQRT(SQR(u->x[0]) + SQR(u->y[0]) + SQR(u->z[0])); CHECK(norm > RL(0.0));
+        t->sum[j] += LOG(norm);
+        u->x[0] /= norm;
+        u->y[0] /= norm;
+        u->z[0] /= norm;
+    }
+}
+
+static void _advance_v_ (xyz *_, tangents *t, controls *c, const model *p) {
+    _diff_v_(_, t->v, 3, p, c->order);
+    real h = _advance_(_, c, c->step);
+    for (int j = 0; j < 3; j++) _next_(&t->v[j], c->order, h);
+    _renormalise_(t);  // cheap compared with the jets, and strongly contracting directions need it
+}
+
+void tsm_flow (controls *c, xyz *_, tangents *t, const model *p, triplet *s, triplet *v) {
+    _->x[0] = s->x;
+    _->y[0] = s->y;
+    _->z[0] = s->z;
+    for (int j = 0; j < 3; j++) {
+        t->v[j].x[0] = j == 0 ? RL(1.0) : RL(0.0);
+        t->v[j].y[0] = j == 1 ? RL(1.0) : RL(0.0);
+        t->v[j].z[0] = j == 2 ? RL(1.0) : RL(0.0);
+    }
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_v_(_, t->v, 3, p, c->order);
+        real h = _advance_(_, c, c->step);
+        for (int j = 0; j < 3; j++) _next_(&t->v[j], c->order, h);
+    }
+    *s = (triplet){_->x[0], _->y[0], _->z[0]};
+    *v = ode(_->x, _->y, _->z, p, 0);
+}
+
+real lyap_map (controls *c, xyz *_, xyz *d, const model *p, bool fli) {
+    real stretch = RL(0.0), most = RL(0.0);
+    d->x[0] = d->y[0] = d->z[0] = SQRT(RL(1.0) / RL(3.0));
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_v_(_, d, 1, p, c->order);
+        if (!_finite_(_, c->order) || !_finite_(d, c->order)) return NAN;
+        real h = _advance_(_, c, c->step);
+        _next_(d, c->order, h);
+        real norm = SQRT(SQR(d->x[0]) + SQR(d->y[0]) + SQR(d->z[0]));
+        if (!(norm > RL(0.0))) return NAN;
+        stretch += LOG(norm);
+        most = FMAX(most, stretch);
+        d->x[0] /= norm;
+        d->y[0] /= norm;
+        d->z[0] /= norm;
+    }
+    return fli ? most : stretch / c->t;
+}
+
+bool lyap_gen (controls *c, xyz *_, tangents *t, const model *p) {
+    if (c->looping) goto resume; else c->looping = true;
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _advance_v_(_, t, c, p);
+        return true;
+        resume: ;
+    }
+    return c->looping = false;
+}
+
+void lyap_tsm (controls *c, xyz *_, tangents *t, const model *p, clock_t t0) {
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _advance_v_(_, t, c, p);
+        if ((c->step + 1) % c->stride && c->step + 1 != c->steps) continue;
+        real l1 = t->sum[0] / c->t, l2 = t->sum[1] / c->t, l3 = t->sum[2] / c->t;
+        if (c->binary) {
+            out_record((real []){l1, l2, l3, c->t}, 4);
+        } else {
+            char s1[OUT_REAL], s2[OUT_REAL], s3[OUT_REAL], sum[OUT_REAL];
+            printf("%s %s %s %.6Le %s %.3Lf\n", out_real(s1, "+", c->dp, l1), out_real(s2, "+", c->dp, l2), out_real(s3, "+", c->dp, l3),
+                   (long double)c->t, out_real(sum, "+", c->dp, l1 + l2 + l3), (long double)(clock() - t0) / CLOCKS_PER_SEC);
+        }
+    }
+}
+
+sensitivities *sens_init (int n, const int *which, int o) {
+    CHECK(n > 0);
+    size_t head = _line_(sizeof (sensitivities)) + _line_((size_t)n * sizeof (int)) + (size_t)n * sizeof (xyz);
+    arena a = tsm_arena(head, 3 * n, o + 1);
+    sensitivities *_ = tsm_take(&a, sizeof (sensitivities));
+    _->n = n;
+    _->p = tsm_take(&a, (size_t)n * sizeof (int));
+    _->s = tsm_take(&a, (size_t)n * sizeof (xyz));
+    for (int j = 0; j < n; j++) {
+        _->p[j] = which[j];
+        _->s[j].x = tsm_arena_jet(&a, o + 1);
+        _->s[j].y = tsm_arena_jet(&a, o + 1);
+        _->s[j].z = tsm_arena_jet(&a, o + 1);
+    }
+    return _;
+}
+
+static void _diff_s_ (xyz *_, sensitivities *s, const model *p, int o) {  // dS/dt = J S + dV/dp, in step with the state
+    OPEN_STEP(o);
+    for (int k = 0; k < o; k++) {
+        NEXT_K();
+        triplet v = ode(_->x, _->y, _->z, p, k);
+        _->x[k + 1] = v.x / (k + 1);
+        _->y[k + 1] = v.y / (k + 1);
+        _->z[k + 1] = v.z / (k + 1);
+        for (int j = 0; j < s->n; j++) {
+            xyz *d = &s->s[j];
+            triplet w = tangent(d->x, d->y, d->z, _->x, _->y, _->z, p, k);
+            triplet f = ode_p(_->x, _->y, _->z, p, s->p[j], k);
+            d->x[k + 1] = (w.x + f.x) / (k + 1);
+            d->y[k + 1] = (w.y + f.y) / (k + 1);
+            d->z[k + 1] = (w.z + f.z) / (k + 1);
+        }
+    }
+    CLOSE_STEP();
+}
+
+static void _write_s_ (const controls *c, const xyz *_, const sensitivities *s, clock_t since) {
+    if (c->binary) {
+        real r[4 + 3 * s->n];
+        r[0] = _->x[0]; r[1] = _->y[0]; r[2] = _->z[0]; r[3] = c->t;
+        for (int j = 0; j < s->n; j++) {
+            r[4 + 3 * j] = s->s[j].x[0]; r[5 + 3 * j] = s->s[j].y[0]; r[6 + 3 * j] = s->s[j].z[0];
+        }
+        out_record(r, 4 + 3 * s->n);
+        return;
+    }
+    char sx[OUT_REAL], sy[OUT_REAL], sz[OUT_REAL];
+    printf("%s %s %s %.6Le", out_real(sx, "+", c->dp, _->x[0]), out_real(sy, "+", c->dp, _->y[0]), out_real(sz, "+", c->dp, _->z[0]), (long double)c->t);
+    for (int j = 0; j < s->n; j++) {
+        printf(" %s %s %s", out_real(sx, "+", c->dp, s->s[j].x[0]), out_real(sy, "+", c->dp, s->s[j].y[0]), out_real(sz, "+", c->dp, s->s[j].z[0]));
+    }
+    printf(" %.3Lf\n", (long double)(clock() - since) / CLOCKS_PER_SEC);
+}
+
+void sens_tsm (controls *c, xyz *_, sensitivities *s, const model *p, clock_t t0) {
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_s_(_, s, p, c->order);
+        if (out_due(c)) _write_s_(c, _, s, t0);
+        real h = _advance_(_, c, c->step);
+        for (int j = 0; j < s->n; j++) _next_(&s->s[j], c->order, h);
+    }
+    _write_s_(c, _, s, t0);
+}
+
+event *tsm_event (const char *spec) {
+    event *_ = malloc(sizeof (event)); CHECK(_);
+    *_ = (event){.a = RL(0.0), .b = RL(0.0), .c = RL(0.0), .d = RL(0.0), .slope = false, .dir = 0, .name = spec[0]};
+    switch (spec[0]) {
+        case 'x': _->a = RL(1.0); break;
+        case 'y': _->b = RL(1.0); break;
+        case 'z': _->c = RL(1.0); break;
+        default: CHECK(spec[0] == 'x' || spec[0] == 'y' || spec[0] == 'z');
+    }
+    const char *rest = spec + 2;
+    if (spec[1] == '\'') {
+        _->slope = true;
+    } else {
+        CHECK(spec[1] == '=');
+        char *end;
+        _->d = STRTOR(rest, &end); CHECK(end != rest);
+        rest = end;
+    }
+    _->dir = *rest == '+' ? 1 : (*rest == '-' ? -1 : 0);
+    return _;
+}
+
+static void _event_jets_ (const xyz *_, const event *e, int o, series g, series dg) {  // g(tau) and g'(tau) on this step
+    for (int k = 0; k <= o; k++) {
+        g[k] = e->slope ? (k < o ? (k + 1) * (e->a * _->x[k + 1] + e->b * _->y[k + 1] + e->c * _->z[k + 1]) : RL(0.0))
+                        : e->a * _->x[k] + e->b * _->y[k] + e->c * _->z[k] - (k ? RL(0.0) : e->d);
+    }
+    for (int k = 0; k < o; k++) dg[k] = (k + 1) * g[k + 1];
+    dg[o] = RL(0.0);
+}
+
+static real _root_ (const series g, const series dg, int o, real h, real g0, real g1) {  // safeguarded Newton
+    real lo = RL(0.0), hi = h, tau = h * g0 / (g0 - g1);
+    for (int i = 0; i < 64; i++) {
+        real v = horner(g, o, tau);
+        if (v == RL(0.0)) break;
+        if ((v < RL(0.0)) == (g0 < RL(0.0))) lo = tau; else hi = tau;
+        real slope = horner(dg, o, tau), next = slope != RL(0.0) ? tau - v / slope : RL(0.5) * (lo + hi);
+        if (next <= lo || next >= hi) next = RL(0.5) * (lo + hi);  // outside the bracket, bisect
+        if (FABS(next - tau) <= RL(4.0) * REAL_EPSILON * h) {
+            tau = next;
+            break;
+        }
+        tau = next;
+    }
+    return tau;
+}
+
+void tsm_events (controls *c, xyz *_, const model *p, const event *e, clock_t t0) {
+    series g = tsm_jet(c->order + 1), dg = tsm_jet(c->order + 1);
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_(_, p, c->order);
+        real h = _h_(_, c);
+        _event_jets_(_, e, c->order, g, dg);
+        real g0 = g[0], g1 = horner(g, c->order, h);
+        if ((g0 < RL(0.0) && g1 >= RL(0.0) && e->dir >= 0) || (g0 > RL(0.0) && g1 <= RL(0.0) && e->dir <= 0)) {
+            real tau = g1 == RL(0.0) ? h : _root_(g, dg, c->order, h, g0, g1);
+            char tag = e->slope && e->name ? (g0 < RL(0.0) ? e->name : (char)toupper(e->name)) : (g0 < RL(0.0) ? '+' : '-');
+            _out_(c, horner(_->x, c->order, tau), horner(_->y, c->order, tau), horner(_->z, c->order, tau), c->t + tau, tag, '_', '_', t0);
+        }
+        _advance_(_, c, c->step);
+    }
+}
+
+void tsm_dense (controls *c, xyz *_, const model *p, real dt, clock_t t0) {
+    CHECK(dt > RL(0.0));
+    long sample = 0;
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
         _diff_(_, p, c->order);
-        _out_(c->dp, _->x[0], _->y[0], _->z[0], c->h * step, _tp_(_->x, &vX, 'x'), _tp_(_->y, &vY, 'y'), _tp_(_->z, &vZ, 'z'), t0);
-        _next_(_, c->order, c->h);
+        real h = _h_(_, c);
+        for (real tau; (tau = dt * (real)sample - c->t) < h; sample++) {
+            _out_(c, horner(_->x, c->order, tau), horner(_->y, c->order, tau), horner(_->z, c->order, tau), dt * (real)sample, '_', '_', '_', t0);
+        }
+        _advance_(_, c, c->step);
+    }
+    if (FABS(dt * (real)sample - c->t) <= RL(4.0) * REAL_EPSILON * c->t) _out_(c, _->x[0], _->y[0], _->z[0], c->t, '_', '_', '_', t0);
+}
+
+void tsm_jets (controls *c, xyz *_, const model *p) {
+    int n = 3 * (c->order + 1) + 2;
+    series r = tsm_jet(n);
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_(_, p, c->order);
+        real h = _h_(_, c);
+        if (out_due(c)) {
+            r[0] = c->t;
+            r[1] = h;
+            for (int k = 0; k <= c->order; k++) {
+                r[2 + k] = _->x[k];
+                r[3 + c->order + k] = _->y[k];
+                r[4 + 2 * c->order + k] = _->z[k];
+            }
+            if (c->binary) {
+                out_record(r, n);
+            } else {
+                char st[OUT_REAL], sh[OUT_REAL];
+                printf("%s %s", out_real(st, "", 21, r[0]), out_real(sh, "", 21, r[1]));
+                for (int i = 2; i < n; i++) printf(" %s", out_real(st, "+", c->dp, r[i]));
+                printf("\n");
+            }
+        }
+        _advance_(_, c, c->step);
+    }
+}
+
+ensemble *ens_init (char **argv, int o) {
+    int size = 1, n = 1;
+    series ic = malloc(3 * sizeof (real)); CHECK(ic);
+    for (int i = 0; i < 3; i++) ic[i] = STRTOR(argv[5 + i], NULL);
+    char x[OUT_REAL], y[OUT_REAL], z[OUT_REAL];  // text, so that STRTOR reads each at the full precision of real
+    while (scanf("%127s %127s %127s", x, y, z) == 3) {
+        if (n == size) {
+            size *= 2;
+            ic = realloc(ic, 3 * (size_t)size * sizeof (real)); CHECK(ic);
+        }
+        ic[3 * n] = STRTOR(x, NULL); ic[3 * n + 1] = STRTOR(y, NULL); ic[3 * n + 2] = STRTOR(z, NULL);
+        n++;
+    }
+    size_t jet = _line_((size_t)((o + 1) * n) * sizeof (real)), v = _line_((size_t)n * sizeof (real));
+    arena a = _arena_(_line_(sizeof (ensemble)) + 3 * jet + 3 * v);
+    ensemble *_ = tsm_take(&a, sizeof (ensemble));
+    _->n = n;
+    _->x = tsm_arena_jet(&a, (o + 1) * n);
+    _->y = tsm_arena_jet(&a, (o + 1) * n);
+    _->z = tsm_arena_jet(&a, (o + 1) * n);
+    _->vx = tsm_arena_jet(&a, n);
+    _->vy = tsm_arena_jet(&a, n);
+    _->vz = tsm_arena_jet(&a, n);
+    for (int m = 0; m < n; m++) {
+        _->x[m] = ic[3 * m];
+        _->y[m] = ic[3 * m + 1];
+        _->z[m] = ic[3 * m + 2];
+    }
+    free(ic);
+    return _;
+}
+
+void ens_horner (series u, int o, real h, int n) {
+    for (int i = o - 1; i >= 0; i--) {
+        real *restrict a = u + i * n;
+        const real *restrict b = a + n;
+        for (int m = 0; m < n; m++) a[m] = b[m] * h + a[m];
+    }
+}
+
+static void _diff_e_ (ensemble *_, const model *p, int o) {
+    int n = _->n;
+    for (int k = 0; k < o; k++) {
+        ode_e(_->vx, _->vy, _->vz, _, p, k);
+        real *restrict x = _->x + (k + 1) * n, *restrict y = _->y + (k + 1) * n, *restrict z = _->z + (k + 1) * n;
+        for (int m = 0; m < n; m++) {
+            x[m] = _->vx[m] / (k + 1);
+            y[m] = _->vy[m] / (k + 1);
+            z[m] = _->vz[m] / (k + 1);
+        }
+    }
+}
+
+static void _next_e_ (ensemble *_, int o, real h) {
+    ens_horner(_->x, o, h, _->n);
+    ens_horner(_->y, o, h, _->n);
+    ens_horner(_->z, o, h, _->n);
+    for (int m = 0; m < _->n; m++) {  // a diverged member stays NaN, the others go on
+        if (!isfinite(_->x[m]) || !isfinite(_->y[m]) || !isfinite(_->z[m])) _->x[m] = _->y[m] = _->z[m] = NAN;
+    }
+}
+
+bool ens_gen (controls *c, ensemble *_, const model *p) {
+    if (c->looping) goto resume; else c->looping = true;
+    CHECK(c->tol == RL(0.0));
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        _diff_e_(_, p, c->order);
+        _next_e_(_, c->order, c->h);
+        return true;
+        resume: ;
+    }
+    return c->looping = false;
+}
+
+void ens_tsm (controls *c, ensemble *_, const model *p, clock_t t0) {
+    CHECK(c->tol == RL(0.0));
+    for (long step = 0; step < c->steps; step++) {
+        _diff_e_(_, p, c->order);
+        _next_e_(_, c->order, c->h);
+    }
+    int invalid = 0;
+    for (int m = 0; m < _->n; m++) {
+        invalid += !isfinite(_->x[m]);
+        _out_(c, _->x[m], _->y[m], _->z[m], c->h * (real)c->steps, '_', '_', '_', t0);
+    }
+    fprintf(stderr, "%s%d%s members, %s%d%s diverged\n", WHT, _->n, GRY, invalid ? RED : WHT, invalid, NRM);
+}
+
+#else
+
+state *tsm_state (int n, int o) {
+    CHECK(n > 0);
+    int stride = (int)(_line_((size_t)(o + 1) * sizeof (real)) / sizeof (real));
+    arena a = _arena_(_line_(sizeof (state)) + _line_((size_t)n * (size_t)stride * sizeof (real)) + _line_((size_t)n * sizeof (real)));
+    state *_ = tsm_take(&a, sizeof (state));
+    _->n = n;
+    _->stride = stride;
+    _->u = tsm_arena_jet(&a, n * stride);
+    _->v = tsm_arena_jet(&a, n);
+    return _;
+}
+
+void tsm_header_n (const controls *c, int argc, char **argv, const state *s) {
+    if (!c->binary) return;  // no header for text, and no need to build one
+    int digits = 1;
+    for (int n = s->n - 1; n >= 10; n /= 10) digits++;
+    char *columns = malloc((size_t)s->n * (size_t)(digits + 2) + 2); CHECK(columns);  // "x<digits> " each, then "t"
+    char *col = columns;
+    for (int i = 0; i < s->n; i++) col += sprintf(col, "x%d ", i);
+    sprintf(col, "t");
+    out_header(c, argc, argv, columns);
+    free(columns);
+}
+
+static void _coefficient_n_ (state *_, const model *p, int k, int lo, int hi) {
+    if (lo >= hi) return;
+    NEXT_K();
+    ode_n(_->v, _, p, k, lo, hi);
+    for (int i = lo; i < hi; i++) _->u[i * _->stride + k + 1] = _->v[i] / (k + 1);
+}
+
+static real _norm_n_ (const state *_, int k, int lo, int hi) {
+    real norm = RL(0.0);
+    for (int i = lo; i < hi; i++) norm = FMAX(norm, FABS(_->u[i * _->stride + k]));
+    return norm;
+}
+
+static real _h_n_ (const controls *c, const real *norm) {  // from the norms of coefficients order - 1 and order, as _step_size_()
+    if (c->tol == RL(0.0)) return c->h;
+    real h = HUGE_VALR;
+    for (int j = 0; j < 2; j++) if (norm[j] > RL(0.0)) h = FMIN(h, POW(c->tol / norm[j], RL(1.0) / (c->order - 1 + j)));
+    return isfinite(h) ? h : RL(1.0);
+}
+
+static void _next_n_ (state *_, int o, real h, int lo, int hi) {
+    for (int i = lo; i < hi; i++) _->u[i * _->stride] = _horner_(_->u + i * _->stride, o, h);
+}
+
+bool tsm_n_gen (controls *c, state *_, const model *p) {
+    if (c->looping) goto resume; else c->looping = true;
+    c->t = RL(0.0);
+    for (c->step = 0; c->step < c->steps; c->step++) {
+        OPEN_STEP(c->order);
+        for (int k = 0; k < c->order; k++) _coefficient_n_(_, p, k, 0, _->n);
+        CLOSE_STEP();
+        real h = c->tol > RL(0.0) ? _h_n_(c, (real []){_norm_n_(_, c->order - 1, 0, _->n), _norm_n_(_, c->order, 0, _->n)}) : c->h;
+        _next_n_(_, c->order, h, 0, _->n);
+        c->t = c->tol > RL(0.0) ? c->t + h : c->h * (real)(c->step + 1);
+        return true;
+        resume: ;
+    }
+    return c->looping = false;
+}
+
+static void _out_n_ (const controls *c, const state *_, real *record, clock_t since) {
+    if (c->binary) {
+        for (int i = 0; i < _->n; i++) record[i] = _->u[i * _->stride];
+        record[_->n] = c->t;
+        out_record(record, _->n + 1);
+        return;
+    }
+    char s[OUT_REAL];
+    for (int i = 0; i < _->n; i++) printf("%s ", out_real(s, "+", c->dp, _->u[i * _->stride]));
+    printf("%.6Le %.3Lf\n", (long double)c->t, (long double)(clock() - since) / CLOCKS_PER_SEC);
+}
+
+typedef struct Pool {
+    controls *c;
+    state *s;
+    const model *p;
+    int threads, chunk;
+    real *norm, *record;  // partial norms of coefficients order - 1 and order, two per thread
+    clock_t since;
+    pthread_barrier_t barrier;
+} pool;
+
+typedef struct Worker {
+    pool *pool;
+    int id;
+} worker;
+
+static void *_worker_n_ (void *arg) {  // worker 0 is the calling thread, and does the output
+    const worker *w = arg;
+    pool *_ = w->pool;
+    controls *c = _->c;
+    state *s = _->s;
+    int lo = w->id * _->chunk < s->n ? w->id * _->chunk : s->n, hi = lo + _->chunk < s->n ? lo + _->chunk : s->n;
+    for (long step = 0; step < c->steps; step++) {
+        if (!w->id) {
+            c->step = step;
+            if (out_due(c)) _out_n_(c, s, _->record, _->since);  // reads coefficient 0 only, so others may go ahead
+        }
+        OPEN_STEP(c->order);  // this thread's products, for its own variables
+        for (int k = 0; k < c->order; k++) {
+            _coefficient_n_(s, _->p, k, lo, hi);
+            if (k == c->order - 1 && c->tol > RL(0.0)) {
+                _->norm[2 * w->id] = _norm_n_(s, k, lo, hi);
+                _->norm[2 * w->id + 1] = _norm_n_(s, k + 1, lo, hi);
+            }
+            pthread_barrier_wait(&_->barrier);  // one per coefficient, all of k + 1 is in place
+        }
+        CLOSE_STEP();
+        real norm[2] = {RL(0.0), RL(0.0)};
+        if (c->tol > RL(0.0)) for (int i = 0; i < _->threads; i++) {
+            norm[0] = FMAX(norm[0], _->norm[2 * i]);
+            norm[1] = FMAX(norm[1], _->norm[2 * i + 1]);
+        }
+        real h = _h_n_(c, norm);  // every thread agrees on the step size
+        _next_n_(s, c->order, h, lo, hi);
+        if (!w->id) c->t = c->tol > RL(0.0) ? c->t + h : c->h * (real)(step + 1);
+        pthread_barrier_wait(&_->barrier);
     }
-    _out_(c->dp, _->x[0], _->y[0], _->z[0], c->h * c->steps, '_', '_', '_', t0);
+    return NULL;
+}
+
+void tsm_n (controls *c, state *s, const model *p, int threads, clock_t t0) {
+    CHECK(threads > 0);
+    pool *_ = malloc(sizeof (pool)); CHECK(_);
+    int grain = LINE / (int)sizeof (real);  // whole cache lines of velocities for each thread
+    *_ = (pool){.c = c, .s = s, .p = p, .threads = threads, .since = t0};
+    _->chunk = ((s->n + threads - 1) / threads + grain - 1) / grain * grain;
+    _->norm = malloc(2 * (size_t)threads * sizeof (real)); CHECK(_->norm);
+    _->record = malloc((size_t)(s->n + 1) * sizeof (real)); CHECK(_->record);
+    CHECK(!pthread_barrier_init(&_->barrier, NULL, (unsigned)threads));
+    worker *w = malloc((size_t)threads * sizeof (worker)); CHECK(w);
+    pthread_t *t = malloc((size_t)threads * sizeof (pthread_t)); CHECK(t);
+    c->t = RL(0.0);
+    for (int i = 0; i < threads; i++) w[i] = (worker){_, i};
+    for (int i = 1; i < threads; i++) CHECK(!pthread_create(&t[i], NULL, _worker_n_, &w[i]));
+    _worker_n_(&w[0]);
+    for (int i = 1; i < threads; i++) pthread_join(t[i], NULL);
+    c->step = c->steps;
+    _out_n_(c, s, _->record, t0);
 }
 
+#endif
+
 real t_const (const real value, int k) {
-    return k ? 0.0L : value;
+    COUNT(P_CONST, k);
+    return k ? RL(0.0) : value;
 }
 
 real t_abs (const series u, int k) {
-    if (!k) CHECK(u[0] != 0.0L);
-    return u[0] < 0.0L ? -u[k] : u[k];
+    COUNT(P_ABS, k);
+    if (!k) CHECK(u[0] != RL(0.0));
+    return u[0] < RL(0.0) ? -u[k] : u[k];
 }
 
 static real _cauchy_ (const series b, const series a, int k, int k0, int k1) {
-    real _ = 0.0L;
+    COUNT(P_CAUCHY, k1 >= k0 ? k1 - k0 + 1 : 0);
+    real _ = RL(0.0);
     for (int j = k0; j <= k1; j++) _ += b[j] * a[k - j];
     return _;
 }
 
+#ifdef TSM_RELAXED  // relaxed (online) products, make MUL=relaxed
+#define EDGE 128  // coefficient pairs with an index below EDGE - 1 are summed directly, the rest in blocks from EDGE up
+#define KARATSUBA 32  // naive block products up to this size
+
+typedef enum { NONE, MUL, SQR, DIV, CHAIN, CHAIN_R } product;
+
+typedef struct Relaxed {  // one product during a step
+    product kind;
+    int n;  // last stage done
+    series c, d, w;  // partial sums of coefficients n onwards, derivative for _chain_(), block scratch
+} relaxed;
+
+typedef struct Products {  // those of a step, in the order they are made at every k, kept by the thread for its next step
+    int order, size, used, next;  // order is that of the storage, the highest so far
+    relaxed *r;
+} products;
+
+static int _relaxed_from_ = RELAXED_FROM;  // lowest order using relaxed products, RELAXED=<order> in the environment
+static pthread_key_t _kept_;  // releases the products of a thread at its exit
+static pthread_once_t _once_ = PTHREAD_ONCE_INIT;
+static __thread products *_mine_ = NULL;  // this thread's products, between steps too
+static __thread products *_products_ = NULL;  // the same, during a step that uses them
+
+static void _release_ (void *arg) {
+    products *m = arg;
+    for (int i = 0; i < m->size; i++) {
+        free(m->r[i].c);
+        free(m->r[i].d);
+        free(m->r[i].w);
+    }
+    free(m->r);
+    free(m);
+}
+
+static void _key_ (void) {
+    CHECK(!pthread_key_create(&_kept_, _release_));
+}
+
+static void _open_ (int o) {
+    CHECK(!_products_);
+    if (o < _relaxed_from_) return;  // direct sums
+    products *m = _mine_;
+    if (!m || o > m->order) {  // new, or too small
+        if (m) _release_(m);
+        m = _mine_ = calloc(1, sizeof (products)); CHECK(m);
+        m->order = o;
+        CHECK(!pthread_once(&_once_, _key_) && !pthread_setspecific(_kept_, m));
+    }
+    for (int i = 0; i < m->size; i++) m->r[i] = (relaxed){.kind = NONE, .n = -1, .c = m->r[i].c, .d = m->r[i].d, .w = m->r[i].w};
+    m->used = m->next = 0;
+    _products_ = m;
+}
+
+static void _restart_ (void) {
+    if (_products_) _products_->next = 0;
+}
+
+static relaxed *_place_ (product kind) {  // the next product in call order, with its storage from the first k that uses it
+    products *m = _products_;
+    if (m->next == m->used) {
+        if (m->used == m->size) {
+            int size = m->size ? 2 * m->size : 16;
+            m->r = realloc(m->r, (size_t)size * sizeof (relaxed)); CHECK(m->r);
+            for (int i = m->size; i < size; i++) m->r[i] = (relaxed){.kind = NONE, .n = -1};
+            m->size = size;
+        }
+        m->used++;
+    }
+    relaxed *_ = &m->r[m->next++];
+    if (kind != NONE && _->kind == NONE) {  // first use in this step
+        size_t size = 2 * (size_t)m->order + 2;  // stage n (below the order) adds to coefficients up to 2n
+        _->kind = kind;
+        if (!_->c) {
+            _->c = malloc(size * sizeof (real)); CHECK(_->c);
+            _->d = malloc(size * sizeof (real)); CHECK(_->d);
+            _->w = malloc(4 * size * sizeof (real)); CHECK(_->w);
+        }
+        memset(_->c, 0, size * sizeof (real));
+    }
+    CHECK(kind == NONE || _->kind == kind);  // the same products in the same order at every k
+    return _;
+}
+
+static void _skip_ (int n) {  // products that start at k = 1 keep their places at k = 0
+    if (_products_) for (int i = 0; i < n; i++) _place_(NONE);
+}
+
+static void _close_ (void) {
+    _products_ = NULL;
+}
+
+static void _karatsuba_ (real *r, const series a, const series b, int n, real *w) {  // r[0, 2n - 1) = a * b, n a power of 2, 4n of w
+    if (n <= KARATSUBA) {
+        for (int k = 0; k < 2 * n - 1; k++) r[k] = _cauchy_(a, b, k, k < n ? 0 : k - n + 1, k < n ? k : n - 1);
+        return;
+    }
+    int h = n / 2;
+    real *sa = w, *sb = w + h, *m = w + 2 * h;
+    _karatsuba_(r, a, b, h, w + 4 * h);
+    _karatsuba_(r + 2 * h, a + h, b + h, h, w + 4 * h);
+    r[2 * h - 1] = RL(0.0);
+    for (int i = 0; i < h; i++) {
+        sa[i] = a[i] + a[h + i];
+        sb[i] = a == b ? sa[i] : b[i] + b[h + i];
+    }
+    _karatsuba_(m, sa, sb, h, w + 4 * h);
+    for (int i = 0; i < 2 * h - 1; i++) m[i] -= r[i] + r[2 * h + i];
+    for (int i = 0; i < 2 * h - 1; i++) r[h + i] += m[i];
+}
+
+static int _growth_ (const series a, int s) {  // binary orders of magnitude per coefficient across a block, from its two halves
+    real lo = RL(0.0), hi = RL(0.0);
+    for (int i = 0; i < s / 2; i++) {
+        lo = FMAX(lo, FABS(a[i]));
+        hi = FMAX(hi, FABS(a[s / 2 + i]));
+    }
+    real _ = LOG(hi / lo) / (RL(0.5) * s * LOG(RL(2.0)));
+    return lo > RL(0.0) && isfinite(_) ? (int)CEIL(_ - RL(0.5)) : 0;  // level if overflowed, the step fails anyway
+}
+
+static void _block_ (relaxed *_, const series a, const series b, int n, int s, real scale) {  // c[n, n + 2s - 1) += scale * a * b
+    real *r = _->w + 4 * s, *sa = r + 2 * s, *sb = sa + s, rho = RL(1.0), p = RL(1.0);
+    int e = (_growth_(a, s) + _growth_(b, s)) / 2;  // coefficients grow or shrink geometrically, Karatsuba wants them level
+    for (int i = 0; i < (e < 0 ? - e : e); i++) rho *= e < 0 ? RL(2.0) : RL(0.5);
+    for (int i = 0; i < s; i++, p *= rho) {
+        sa[i] = a[i] * p;
+        sb[i] = b[i] * p;
+    }
+    _karatsuba_(r, sa, a == b ? sa : sb, s, _->w);
+    p = scale;
+    rho = RL(1.0) / rho;  // exact, a power of 2
+    for (int i = 0; i < 2 * s - 1; i++, p *= rho) _->c[n + i] += p * r[i];
+}
+
+static real _stage_ (relaxed *_, const series a, const series b, int n) {  // van der Hoeven, coefficient n of a * b from a, b up to n
+    CHECK(n == _->n + 1);  // every coefficient in turn, from 0
+    _->n = n;
+    if (n < 2 * EDGE - 2) return _->c[n] = _cauchy_(a, b, n, 0, n);
+    for (int s = EDGE; (n + 2) % s == 0 && n + 2 >= 2 * s; s *= 2) {  // squares of side s along both edges of the triangle
+        if (n + 2 == 2 * s) {
+            _block_(_, a + s - 1, b + s - 1, n, s, RL(1.0));
+        } else if (_->kind == SQR) {
+            _block_(_, a + s - 1, a + n + 1 - s, n, s, RL(2.0));
+        } else {
+            _block_(_, a + s - 1, b + n + 1 - s, n, s, RL(1.0));
+            _block_(_, a + n + 1 - s, b + s - 1, n, s, RL(1.0));
+        }
+    }
+    return _->c[n] += _->kind == SQR ? RL(2.0) * _cauchy_(a, a, n, 0, EDGE - 2) : _cauchy_(a, b, n, 0, EDGE - 2) + _cauchy_(b, a, n, 0, EDGE - 2);
+}
+
+static real _derivative_ (relaxed *_, const series a, const series u, int n) {  // coefficient n of a * u', u' stored as it arrives
+    _->d[n] = (n + 1) * u[n + 1];
+    return _stage_(_, a, _->d, n);
+}
+#endif
+
 real t_mul (const series u, const series v, int k) {
+    COUNT(P_MUL, k);
+#ifdef TSM_RELAXED
+    if (_products_) return u == v ? _stage_(_place_(SQR), u, u, k) : _stage_(_place_(MUL), u, v, k);
+#endif
     return _cauchy_(u, v, k, 0, k);
 }
 
 real t_div (series q, const series u, const series v, int k) {
-    if (k) return q[k] = ((u ? u[k] : 0.0L) - _cauchy_(q, v, k, 0, k - 1)) / v[0];
+    COUNT(P_DIV, k);
+#ifdef TSM_RELAXED
+    if (_products_ && k) return q[k] = ((u ? u[k] : RL(0.0)) - _stage_(_place_(DIV), q, v + 1, k - 1)) / v[0];
+#endif
+    if (k) return q[k] = ((u ? u[k] : RL(0.0)) - _cauchy_(q, v, k, 0, k - 1)) / v[0];
+    SKIP(1);
     CHECK(q != u && q != v);
-    CHECK(v[0] != 0.0L);
-    return q[k] = (u ? u[k] : 1.0L) / v[0];
+    CHECK(v[0] != RL(0.0));
+    return q[k] = (u ? u[k] : RL(1.0)) / v[0];
 }
 
 static real _half_ (const series a, int k, int k0, bool even) {
-    return 2.0L * _cauchy_(a, a, k, k0, (k - (even ? 1 : 2)) / 2) + (even ? 0.0L : SQR(a[k / 2]));
+    return RL(2.0) * _cauchy_(a, a, k, k0, (k - (even ? 1 : 2)) / 2) + (even ? RL(0.0) : SQR(a[k / 2]));
 }
 
 real t_sqr (const series u, int k) {
+    COUNT(P_SQR, k);
+#ifdef TSM_RELAXED
+    if (_products_) return _stage_(_place_(SQR), u, u, k);
+#endif
     return _half_(u, k, 0, k % 2);
 }
 
 real t_sqrt (series r, const series u, int k) {
-    if (k) return r[k] = 0.5L * (u[k] - _half_(r, k, 1, k % 2)) / r[0];
+    COUNT(P_SQRT, k);
+    if (k) return r[k] = RL(0.5) * (u[k] - _half_(r, k, 1, k % 2)) / r[0];
     CHECK(r != u);
-    CHECK(u[0] > 0.0L);
-    return r[k] = sqrtl(u[k]);
+    CHECK(u[0] > RL(0.0));
+    return r[k] = SQRT(u[k]);
 }
 
 real t_pwr (series p, const series u, real a, int k) {
+    COUNT(P_PWR, k);
     if (k) {
-        real _ = 0.0L;
+        real _ = RL(0.0);
         for (int j = 0; j < k; j++) _ += (a * (k - j) - j) * p[j] * u[k - j];
         return p[k] = _ / (k * u[0]);
     }
     CHECK(p != u);
-    CHECK(u[0] > 0.0L);
-    return p[k] = powl(u[k], a);
+    CHECK(u[0] > RL(0.0));
+    return p[k] = POW(u[k], a);
 }
 
 static real _chain_ (const series dfdu, const series u, int k, const series fk, int scale) {
-    real _ = 0.0L;
+#ifdef TSM_RELAXED
+    if (_products_ && fk) {
+        relaxed *r = _place_(CHAIN_R);  // from k = 2 on
+        real _ = k > 1 ? _derivative_(r, dfdu + 1, u, k - 2) : RL(0.0);
+        return (*fk - scale * _ / k) / dfdu[0];
+    }
+    if (_products_) return scale * _derivative_(_place_(CHAIN), dfdu, u, k - 1) / k;
+#endif
+    real _ = RL(0.0);
+    COUNT(P_CHAIN, fk ? k - 1 : k);
     for (int j = fk ? 1 : 0; j < k; j++) _ += dfdu[j] * (k - j) * u[k - j];
     return fk ? (*fk - scale * _ / k) / dfdu[0] : scale * _ / k;  // forward if fk NULL, reverse if non-NULL
 }
 
 real t_exp (series e, const series u, int k) {
+    COUNT(P_EXP, k);
     if (k) return e[k] = _chain_(e, u, k, NULL, 1);
+    SKIP(1);
     CHECK(e != u);
-    return e[k] = expl(u[k]);
+    return e[k] = EXP(u[k]);
 }
 
 real t_ln (series u, const series e, int k) {
+    COUNT(P_LN, k);
     if (k) return u[k] = _chain_(e, u, k, &e[k], 1);
+    SKIP(1);
     CHECK(u != e);
-    CHECK(e[0] > 0.0L);
-    return u[k] = logl(e[k]);
+    CHECK(e[0] > RL(0.0));
+    return u[k] = LOG(e[k]);
 }
 
 pair t_sin_cos (series s, series c, const series u, int k, bool trig) {
-    if (k) return (pair){ s[k] = _chain_(c, u, k, NULL, 1), c[k] = _chain_(s, u, k, NULL, trig ? -1.0L : 1.0L) };
+    COUNT(P_SIN_COS, k);
+    if (k) return (pair){ s[k] = _chain_(c, u, k, NULL, 1), c[k] = _chain_(s, u, k, NULL, trig ? -RL(1.0) : RL(1.0)) };
+    SKIP(2);
     CHECK(s != c && s != u && c != u);
-    return (pair){ s[k] = trig ? sinl(u[k]) : sinhl(u[k]), c[k] = trig ? cosl(u[k]) : coshl(u[k]) };
+    return (pair){ s[k] = trig ? SIN(u[k]) : SINH(u[k]), c[k] = trig ? COS(u[k]) : COSH(u[k]) };
 }
 
 pair t_tan_sec2 (series t, series s, const series u, int k, bool trig) {
-    if (k) return (pair){ t[k] = _chain_(s, u, k, NULL, 1), s[k] = _chain_(t, t, k, NULL, trig ? 2.0L : -2.0L) };
+    COUNT(P_TAN_SEC2, k);
+    if (k) return (pair){ t[k] = _chain_(s, u, k, NULL, 1), s[k] = _chain_(t, t, k, NULL, trig ? RL(2.0) : -RL(2.0)) };
+    SKIP(2);
     CHECK(t != s && t != u && s != u);
-    CHECK(trig ? fabsl(u[0]) < 0.5L * acosl(-1.0L) : true);
-    return (pair){ t[k] = trig ? tanl(u[k]) : tanhl(u[k]), s[k] = trig ? 1.0L + SQR(t[k]) : 1.0L - SQR(t[k]) };
+    CHECK(trig ? FABS(u[0]) < RL(0.5) * ACOS(-RL(1.0)) : true);
+    return (pair){ t[k] = trig ? TAN(u[k]) : TANH(u[k]), s[k] = trig ? RL(1.0) + SQR(t[k]) : RL(1.0) - SQR(t[k]) };
 }
 
 pair t_asin_cos (series u, series c, const series s, int k, bool trig) {
-    if (k) return (pair){ u[k] = _chain_(c, u, k, &s[k], 1), c[k] = _chain_(s, u, k, NULL, trig ? -1.0L : 1.0L) };
+    COUNT(P_ASIN_COS, k);
+    if (k) return (pair){ u[k] = _chain_(c, u, k, &s[k], 1), c[k] = _chain_(s, u, k, NULL, trig ? -RL(1.0) : RL(1.0)) };
+    SKIP(2);
     CHECK(u != c && u != s && c != s);
-    CHECK(trig ? s[0] > -1.0L && s[0] < 1.0L : true);
-    return (pair){ u[k] = trig ? asinl(s[k]) : asinhl(s[k]), c[k] = trig ?  cosl(u[k]) :  coshl(u[k]) };
+    CHECK(trig ? s[0] > -RL(1.0) && s[0] < RL(1.0) : true);
+    return (pair){ u[k] = trig ? ASIN(s[k]) : ASINH(s[k]), c[k] = trig ?  COS(u[k]) :  COSH(u[k]) };
 }
 
 pair t_acos_sin (series u, series s, const series c, int k, bool trig) {
-    if (k) return (pair){ u[k] = _chain_(s, u, k, &c[k], trig ? -1.0L : 1.0L), s[k] = _chain_(c, u, k, NULL, 1) };
+    COUNT(P_ACOS_SIN, k);
+    if (k) return (pair){ u[k] = _chain_(s, u, k, &c[k], trig ? -RL(1.0) : RL(1.0)), s[k] = _chain_(c, u, k, NULL, 1) };
+    SKIP(2);
     CHECK(u != s && u != c && s != c);
-    CHECK(trig ? c[0] > -1.0L && c[0] < 1.0L : c[0] > 1.0L);
-    return (pair){ u[k] = trig ? acosl(c[k]) : acoshl(c[k]), s[k] = trig ? -sinl(u[k]) :  sinhl(u[k]) };
+    CHECK(trig ? c[0] > -RL(1.0) && c[0] < RL(1.0) : c[0] > RL(1.0));
+    return (pair){ u[k] = trig ? ACOS(c[k]) : ACOSH(c[k]), s[k] = trig ? -SIN(u[k]) :  SINH(u[k]) };
 }
 
 pair t_atan_sec2 (series u, series s, const series t, int k, bool trig) {
-    if (k) return (pair){ u[k] = _chain_(s, u, k, &t[k], 1), s[k] = _chain_(t, t, k, NULL, trig ? 2.0L : -2.0L) };
+    COUNT(P_ATAN_SEC2, k);
+    if (k) return (pair){ u[k] = _chain_(s, u, k, &t[k], 1), s[k] = _chain_(t, t, k, NULL, trig ? RL(2.0) : -RL(2.0)) };
+    SKIP(2);
     CHECK(u != s && u != t && s != t);
-    CHECK(trig ? true : t[0] > -1.0L && t[0] < 1.0L);
-    return (pair){ u[k] = trig ? atanl(t[k]) : atanhl(t[k]), s[k] = trig ? 1.0L + SQR(t[k]) : 1.0L - SQR(t[k]) };
+    CHECK(trig ? true : t[0] > -RL(1.0) && t[0] < RL(1.0));
+    return (pair){ u[k] = trig ? ATAN(t[k]) : ATANH(t[k]), s[k] = trig ? RL(1.0) + SQR(t[k]) : RL(1.0) - SQR(t[k]) };
+}
+
+static void _cauchy_e_ (real *restrict r, real a, const series b, const series c, int k, int k0, int k1, int n) {
+    for (int j = k0; j <= k1; j++) {
+        const real *restrict u = b + j * n, *restrict w = c + (k - j) * n;
+        for (int m = 0; m < n; m++) r[m] += a * u[m] * w[m];
+    }
+}
+
+void e_mul (series r, real a, const series u, const series w, int k, int n) {
+    _cauchy_e_(r, a, u, w, k, 0, k, n);
+}
+
+void e_sqr (series r, real a, const series u, int k, int n) {
+    _cauchy_e_(r, RL(2.0) * a, u, u, k, 0, (k - (k % 2 ? 1 : 2)) / 2, n);
+    if (k % 2) return;
+    const real *restrict h = u + k / 2 * n;
+    for (int m = 0; m < n; m++) r[m] += a * SQR(h[m]);
+}
+
+void e_abs (series r, real a, const series u, int k, int n) {
+    const real *restrict uk = u + k * n;
+    for (int m = 0; m < n; m++) {
+        if (!k) CHECK(u[m] != RL(0.0));
+        r[m] += a * (u[m] < RL(0.0) ? -uk[m] : uk[m]);
+    }
+}
+
+static void _chain_e_ (series r, const series dfdu, const series u, int k, int n, real scale) {
+    real *restrict _ = r + k * n;
+    for (int m = 0; m < n; m++) _[m] = RL(0.0);
+    for (int j = 0; j < k; j++) {
+        const real *restrict d = dfdu + j * n, *restrict v = u + (k - j) * n;
+        for (int m = 0; m < n; m++) _[m] += d[m] * (k - j) * v[m];
+    }
+    for (int m = 0; m < n; m++) _[m] = scale * _[m] / k;
+}
+
+void e_exp (series e, const series u, int k, int n) {
+    if (k) { _chain_e_(e, e, u, k, n, RL(1.0)); return; }
+    CHECK(e != u);
+    for (int m = 0; m < n; m++) e[m] = EXP(u[m]);
+}
+
+void e_sin_cos (series s, series c, const series u, int k, int n, bool trig) {
+    if (k) {
+        _chain_e_(s, c, u, k, n, RL(1.0));
+        _chain_e_(c, s, u, k, n, trig ? -RL(1.0) : RL(1.0));
+        return;
+    }
+    CHECK(s != c && s != u && c != u);
+    for (int m = 0; m < n; m++) {
+        s[m] = trig ? SIN(u[m]) : SINH(u[m]);
+        c[m] = trig ? COS(u[m]) : COSH(u[m]);
+    }
+}
+
+void e_tan_sec2 (series t, series s, const series u, int k, int n, bool trig) {
+    if (k) {
+        _chain_e_(t, s, u, k, n, RL(1.0));
+        _chain_e_(s, t, t, k, n, trig ? RL(2.0) : -RL(2.0));
+        return;
+    }
+    CHECK(t != s && t != u && s != u);
+    for (int m = 0; m < n; m++) {
+        CHECK(trig ? !(FABS(u[m]) >= RL(0.5) * ACOS(-RL(1.0))) : true);  // passes NaN, a diverged member
+        t[m] = trig ? TAN(u[m]) : TANH(u[m]);
+        s[m] = trig ? RL(1.0) + SQR(t[m]) : RL(1.0) - SQR(t[m]);
+    }
 }
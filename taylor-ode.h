@@ -19,13 +19,30 @@ typedef struct ts3 {
     series x, y, z;
 } xyz;
 
+/*
+ * Highest order accepted; relaxed builds (make MUL=relaxed) use direct sums below RELAXED_FROM, measured break-even
+ * for Lorenz on x86-64 (long double), and take direct sums to ORDER_MAX too, with RELAXED=<order> to compare them
+ */
+#ifdef TSM_RELAXED
+#define ORDER_MAX 16384
+#define RELAXED_FROM 2000
+#else
+#define ORDER_MAX 64
+#endif
+
 /*
  * Retrieves control parameters from the first four command arguments
  */
 controls *tsm_get_c (int argc, char **argv);
 
 /*
- * Retrieves initial X, Y, Z values from the next three command arguments and populates their Taylor Series'
+ * As tsm_get_c(), without reporting the command, for hosts reading many commands (not thread safe)
+ */
+controls *tsm_read_c (char **argv);
+
+/*
+ * Retrieves initial X, Y, Z values from the next three command arguments and populates their Taylor Series',
+ * all in one arena (released by free())
  */
 xyz *tsm_init (char **argv, int order);
 
@@ -35,17 +52,40 @@ xyz *tsm_init (char **argv, int order);
 void tsm_get_p (char **argv, int count, ...);
 
 /*
- * Creates a Taylor Series with the specified number of elements
+ * Creates a Taylor Series with the specified number of elements, cache line aligned and padded
  */
 series tsm_jet (int size);
 
+/*
+ * Jet arena, one cache line aligned block handed out in whole cache lines, in allocation (and so access) order
+ */
+typedef struct Arena {
+    char *next, *end;
+} arena;
+
+/*
+ * Creates an arena for a header (e.g. a model struct) of "head" bytes, then "jets" series of "size" elements;
+ * the header is the start of the block, so freeing it releases the whole arena
+ */
+arena tsm_arena (size_t head, int jets, int size);
+
+/*
+ * Takes the next "bytes" (zeroed) from the arena, padded to a whole number of cache lines
+ */
+void *tsm_take (arena *a, size_t bytes);
+
+/*
+ * Creates a Taylor Series with the specified number of elements in the arena
+ */
+series tsm_arena_jet (arena *a, int size);
+
 /*
  * Safely and efficiently evaluates a polynomial of degree n, with the coefficients in S, and the variable in h
  */
 real horner (series U, int order, real h);
 
 /*
- *  Run TSM, send data to stdout
+ *  Run TSM, send data to stdout; checkpoints and resumes (see output.h) if ckpt_init() was called
  */
 void tsm (controls *c, xyz *jets, const model *p, clock_t since);
 
@@ -54,12 +94,215 @@ void tsm (controls *c, xyz *jets, const model *p, clock_t since);
  */
 bool tsm_gen (controls *c, xyz *jets, const model *p);
 
+/*
+ * Turning point of a coordinate, with its tsm() output tag (x, y, z minimum, X, Y, Z maximum)
+ */
+typedef struct TurningPoint {
+    real value;
+    char tag;
+} turning;
+
+/*
+ * Silent TSM run, collects the turning points of the last "samples" steps (as in the tail of tsm() output) into *TP,
+ * with the count in *n; the caller frees *TP.  Returns false, instead of aborting, if the solution diverges, with *TP
+ * NULL and *n 0.
+ */
+bool tsm_tp (controls *c, xyz *jets, const model *p, int samples, turning **TP, int *n);
+
+/*
+ * Clean Numerical Simulation, advances the trial (c, jets, p) and a "better" reference (r, ref, q) together,
+ * the reference taking "substeps" steps for each trial step.  Prints the time and trial CPU at which the separation
+ * first exceeds each of the n (ascending) thresholds, stopping after the last.  Returns the number exceeded.
+ */
+int tsm_cns (controls *c, xyz *jets, const model *p, controls *r, xyz *ref, const model *q, int substeps, const real *threshold, int n);
+
+/*
+ * Records a reference solution (r, ref, q) at every "substeps" steps, for steps + 1 points (including the start)
+ */
+triplet *tsm_path (controls *r, xyz *ref, const model *q, int substeps, long steps);
+
+/*
+ * CPU time of the calling thread in seconds, for timing runs that share a process
+ */
+real tsm_thread_cpu (void);
+
+/*
+ * As tsm_cns(), but against a recorded reference PATH, and silent (thread safe); the time and thread CPU at which
+ * each threshold is exceeded are stored in CLEAN.  Returns the number exceeded.
+ */
+int tsm_cns_path (controls *c, xyz *jets, const model *p, const triplet *path, const real *threshold, int n, pair *CLEAN);
+
+/*
+ * Silent fixed step TSM run of c->steps steps from the state *S, which is updated in place; the state at the start
+ * and at every c->stride'th step goes into PATH (c->steps / c->stride + 1 points) unless it is NULL.  Thread safe,
+ * for the Parareal propagators.
+ */
+void tsm_span (controls *c, xyz *jets, const model *p, triplet *S, triplet *PATH);
+
+/*
+ * Tangent (variational) jets, the three columns of the 3 x 3 deviation matrix, with their accumulated log stretches
+ */
+typedef struct Tangents {
+    xyz v[3];
+    real sum[3];
+} tangents;
+
+/*
+ * Creates tangent jets in one arena (released by free()), starting from the identity matrix
+ */
+tangents *lyap_init (int order);
+
+/*
+ * Generator (step-wise) TSM together with the variational equations, renormalising by QR at every step;
+ * the running Lyapunov spectrum is t->sum / c->t
+ */
+bool lyap_gen (controls *c, xyz *jets, tangents *t, const model *p);
+
+/*
+ * Run TSM with the variational equations, sending the running Lyapunov spectrum (and its sum) to stdout every
+ * c->stride steps and at the end
+ */
+void lyap_tsm (controls *c, xyz *jets, tangents *t, const model *p, clock_t since);
+
+/*
+ * Silent TSM run with a single deviation vector D (starting along (1, 1, 1)), renormalised at every step, for chaos maps;
+ * returns the fast Lyapunov indicator (the largest log stretch so far) if fli, otherwise the largest Lyapunov exponent
+ * (the log stretch over the time), or NAN if the solution diverges.  Thread safe.
+ */
+real lyap_map (controls *c, xyz *jets, xyz *D, const model *p, bool fli);
+
+/*
+ * Silent TSM run of c->steps steps from the state *S together with the variational equations, the deviations starting
+ * from the identity and never renormalised, so that t->v ends as the columns of the state transition (monodromy)
+ * matrix; *S is updated in place, and *V set to the velocity there.  For Newton shooting on periodic orbits.
+ */
+void tsm_flow (controls *c, xyz *jets, tangents *t, const model *p, triplet *S, triplet *V);
+
+/*
+ * Forward parameter sensitivities, jets of S = d(X, Y, Z)/dp for each of n chosen model parameters (p holds their
+ * positions in the command list, from 0), all starting at zero
+ */
+typedef struct Sensitivities {
+    int n, *p;
+    xyz *s;
+} sensitivities;
+
+/*
+ * Creates sensitivity jets in one arena (released by free())
+ */
+sensitivities *sens_init (int n, const int *which, int order);
+
+/*
+ * Run TSM with the sensitivity equations dS/dt = J S + dV/dp in the same pass, sending x, y, z, t, then dx/dp, dy/dp,
+ * dz/dp for each chosen parameter, to stdout every c->stride steps and at the end
+ */
+void sens_tsm (controls *c, xyz *jets, sensitivities *s, const model *p, clock_t since);
+
+/*
+ * Event function g, a plane a x + b y + c z - d (Poincare sections) or, if slope, its rate of change (extrema),
+ * crossing zero upwards only (dir > 0), downwards only (dir < 0) or both (dir == 0)
+ */
+typedef struct Event {
+    real a, b, c, d;
+    bool slope;
+    int dir;
+    char name;  // coordinate name for extremum tags, or 0
+} event;
+
+/*
+ * Parses an event from "x=value", "y=value", "z=value" (sections) or "x'", "y'", "z'" (extrema),
+ * each optionally followed by + or - for the crossing direction
+ */
+event *tsm_event (const char *spec);
+
+/*
+ * Run TSM, sending only the states at which the event function crosses zero to stdout; crossings are found inside each
+ * step by Newton's method on the Taylor polynomial of g.  Tags are + or - (direction) for sections, or as for tsm()
+ * for extrema (lower case minimum, upper case maximum).
+ */
+void tsm_events (controls *c, xyz *jets, const model *p, const event *e, clock_t since);
+
+/*
+ * Dense output, run TSM sending the states at t = 0, dt, 2 dt ... to stdout, independent of the step size;
+ * each sample is evaluated by horner() on the jets of the step that contains it
+ */
+void tsm_dense (controls *c, xyz *jets, const model *p, real dt, clock_t since);
+
+/*
+ * Run TSM, sending the start time, step size and x, y, z jets (order + 1 coefficients each) of every c->stride'th step
+ * to stdout, for interpolation elsewhere
+ */
+void tsm_jets (controls *c, xyz *jets, const model *p);
+
+/*
+ * Combined x, y, z ensemble series, stored structure-of-arrays (coefficient k of member m at [k * n + m])
+ */
+typedef struct ts3e {
+    int n;
+    series x, y, z;
+    series vx, vy, vz;  // velocity workspace, one coefficient for each member
+} ensemble;
+
+/*
+ * Retrieves initial X, Y, Z values for member 0 from the command, and for any further members from stdin,
+ * all in one arena (released by free())
+ */
+ensemble *ens_init (char **argv, int order);
+
+/*
+ * Lane-wise Horner's method for all n members, result stored in place (overwrites the higher coefficients)
+ */
+void ens_horner (series U, int order, real h, int n);
+
+/*
+ *  Run TSM for every member of the ensemble in lock-step, send final states to stdout (NaN for a member that diverged,
+ *  which does not stop the others), and the number diverged to stderr
+ */
+void ens_tsm (controls *c, ensemble *jets, const model *p, clock_t since);
+
+/*
+ * Generator (step-wise) implementation of ensemble TSM
+ */
+bool ens_gen (controls *c, ensemble *jets, const model *p);
+
+/*
+ * N-variable state, one contiguous coefficient matrix with a (cache line padded) row of order + 1 coefficients for
+ * each variable, so that the series of variable i is U + i * stride
+ */
+typedef struct tsn {
+    int n, stride;
+    series u;
+    series v;  // velocity workspace, one coefficient for each variable
+} state;
+
+/*
+ * Creates an N-variable state with all series zero, in one arena (released by free())
+ */
+state *tsm_state (int n, int order);
+
+/*
+ * Writes the binary record header (see output.h) for an N-variable run, columns x0 to xn-1, then t
+ */
+void tsm_header_n (const controls *c, int argc, char **argv, const state *s);
+
+/*
+ *  Run N-variable TSM, send data (all n variables, then t) to stdout every c->stride steps and at the end; the variables
+ *  are shared out in contiguous blocks to a pool of "threads" threads (including the caller), which meet at a barrier
+ *  after each coefficient
+ */
+void tsm_n (controls *c, state *s, const model *p, int threads, clock_t since);
+
+/*
+ * Generator (step-wise) implementation of N-variable TSM
+ */
+bool tsm_n_gen (controls *c, state *s, const model *p);
+
 /*
  * Obligatory client method signatures
  */
 
 /*
- * Populate parameter data from command arguments
+ * Populate parameter data from command arguments, model and scratch series in one arena (released by free())
  */
 model *tsm_init_p (int argc, char **argv, int order);
 
@@ -68,6 +311,39 @@ model *tsm_init_p (int argc, char **argv, int order);
  */
 triplet ode (series X, series Y, series Z, const model *p, const int k);
 
+/*
+ * Calculate kth components of the tangent velocity DV = J(X, Y, Z) D, for the deviation D (DX, DY, DZ), using the
+ * linearised ODE model.  Called after ode() for the same k, so any scratch series from ode() are valid to k.
+ */
+triplet tangent (series DX, series DY, series DZ, series X, series Y, series Z, const model *p, const int k);
+
+/*
+ * Calculate kth components of the explicit derivative dV/dp of the velocity with respect to model parameter i (its
+ * position in the command list, from 0), through any parameters derived from it.  Called after ode() for the same k.
+ */
+triplet ode_p (series X, series Y, series Z, const model *p, const int i, const int k);
+
+/*
+ * Lane-wise ode(), calculate kth components of the velocities VX, VY, VZ for every member of the ensemble.
+ * Model scratch series are sized for the whole ensemble by passing order * members to tsm_init_p().
+ */
+void ode_e (series VX, series VY, series VZ, const ensemble *e, const model *p, const int k);
+
+/*
+ * Obligatory N-variable client method signatures, instead of all of the above (taylor-ode.c built with -DTSM_N)
+ */
+
+/*
+ * Populate parameter data from command arguments (argument 5 onwards), and create the state *S with its initial values
+ */
+model *tsm_init_n (int argc, char **argv, int order, state **S);
+
+/*
+ * Calculate kth components of the velocities V of variables lo to hi - 1.  Ranges are disjoint, but may be evaluated
+ * concurrently, so any model scratch written must belong to those variables only (best with the stride of S).
+ */
+void ode_n (series V, const state *S, const model *p, const int k, int lo, int hi);
+
 /*
  * Basic Taylor Series functions
  */
@@ -84,6 +360,10 @@ real t_abs (const series U, int k);
 
 /*
  * Taylor Series recurrence relationships
+ *
+ * With make MUL=relaxed, the products and chain rules below carry partial sums from one k to the next, within each TSM step,
+ * in storage for that step alone; at every k of a step the model must make the same calls in the same order (as generated
+ * models do).  Outside a TSM step (e.g. in tests) they are summed directly.
  */
 
 /*
@@ -145,3 +425,37 @@ pair t_atan_sec2 (series U, series SEC2, const series TAN, int k, bool trig);
  * Returns kth element of P = U^a (where a is scalar), results stored in PWR
  */
 real t_pwr (series PWR, const series U, real a, int k);
+
+/*
+ * Lane-wise (ensemble) Taylor Series recurrence relationships, n members, coefficient k of member m at [k * n + m]
+ */
+
+/*
+ * Adds a times the kth elements of the products of U and W to R, no storage needed
+ */
+void e_mul (series R, real a, const series U, const series W, int k, int n);
+
+/*
+ * Adds a times the kth elements of the squares of U to R, no storage needed
+ */
+void e_sqr (series R, real a, const series U, int k, int n);
+
+/*
+ * Adds a times the kth elements of the absolute values of U to R, no storage needed
+ */
+void e_abs (series R, real a, const series U, int k, int n);
+
+/*
+ * Calculates kth elements of the exponentials of U, results stored in EXP
+ */
+void e_exp (series EXP, const series U, int k, int n);
+
+/*
+ * Calculates kth elements of both SIN/SINH and COS/COSH of U, results stored in SIN/SINH and COS/COSH
+ */
+void e_sin_cos (series SIN, series COS, const series U, int k, int n, bool trig);
+
+/*
+ * Calculates kth elements of both TAN/TANH and SEC2/SECH2 of U, results stored in TAN/TANH and SEC2/SECH2
+ */
+void e_tan_sec2 (series TAN, series SEC2, const series U, int k, int n, bool trig);
@@ -0,0 +1,31 @@
+/*
+ * Bouali Attractor, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-bouali.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a, b, c, d; mseries sa, sb; };
+
+model *tsm_init_p (int argc, char **argv, int n) {
+    CHECK(argc == 12);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->sa = md_jet(n);
+    _->sb = md_jet(n);
+    md_get_p(argv, argc, &_->a, &_->b, &_->c, &_->d);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    _->sa[k] = md_sub(m_const(md_d(1.0), k), y[k]);
+    _->sb[k] = md_sub(m_const(md_d(1.0), k), m_sqr(x, k));
+    return (mtriplet) {
+        .x = md_sub(md_mul(_->a, m_mul(x, _->sa, k)), md_mul(_->b, z[k])),
+        .y = md_neg(md_mul(_->c, m_mul(y, _->sb, k))),
+        .z = md_mul(_->d, x[k])
+    };
+}
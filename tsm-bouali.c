@@ -1,30 +1,90 @@
 /*
  * Bouali Attractor
  *
+ * Generated by tsm-compile.py from tsm-bouali.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real a, b, c, d; series sa, sb, _1; };
+struct Parameters { real a, b, c, d; series sa, sb, xy; };
 
 model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 12);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    _->sa = tsm_jet(n);
-    _->sb = tsm_jet(n);
-    _->_1 = tsm_jet(n); _->_1[0] = 1.0L;
+    arena a = tsm_arena(sizeof (model), 3, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->sa = tsm_arena_jet(&a, n);
+    _->sb = tsm_arena_jet(&a, n);
+    _->xy = tsm_arena_jet(&a, n);
     tsm_get_p(argv, argc, &_->a, &_->b, &_->c, &_->d);
     return _;
 }
 
 triplet ode (series x, series y, series z, const model *_, const int k) {
-    _->sa[k] = _->_1[k] - y[k];
-    _->sb[k] = _->_1[k] - t_sqr(x, k);
+    _->sa[k] = t_const(RL(1.0), k) - y[k];
+    _->sb[k] = t_const(RL(1.0), k) - t_sqr(x, k);
     return (triplet) {
         .x = _->a * t_mul(x, _->sa, k) - _->b * z[k],
         .y = - _->c * t_mul(y, _->sb, k),
         .z = _->d * x[k]
     };
 }
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) { (void)z;
+    _->xy[k] = t_mul(x, y, k);
+    return (triplet) {
+        .x = _->a * (t_mul(_->sa, dx, k) - t_mul(x, dy, k)) - _->b * dz[k],
+        .y = RL(2.0) * _->c * t_mul(dx, _->xy, k) - _->c * t_mul(_->sb, dy, k),
+        .z = _->d * dx[k]
+    };
+}
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) {
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = t_mul(x, _->sa, k),
+            .y = RL(0.0),
+            .z = RL(0.0)
+        };
+    case 1:
+        return (triplet) {
+            .x = - z[k],
+            .y = RL(0.0),
+            .z = RL(0.0)
+        };
+    case 2:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = - t_mul(y, _->sb, k),
+            .z = RL(0.0)
+        };
+    case 3:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = x[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    const series sa = _->sa + k * n, sb = _->sb + k * n;
+    for (int m = 0; m < n; m++) {
+        sa[m] = t_const(RL(1.0), k) - y[m];
+        sb[m] = t_const(RL(1.0), k);
+    }
+    e_sqr(sb, -RL(1.0), e->x, k, n);
+    for (int m = 0; m < n; m++) {
+        vx[m] = - _->b * z[m];
+        vy[m] = RL(0.0);
+        vz[m] = _->d * x[m];
+    }
+    e_mul(vx, _->a, e->x, _->sa, k, n);
+    e_mul(vy, - _->c, e->y, _->sb, k, n);
+}
@@ -0,0 +1,27 @@
+/*
+ * Burke & Shaw System - http://www.atomosyd.net/spip.php?article33, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-burke-shaw.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md s, v; };
+
+model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+    CHECK(argc == 10);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    md_get_p(argv, argc, &_->s, &_->v);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    return (mtriplet) {
+        .x = md_neg(md_mul(_->s, md_add(x[k], y[k]))),
+        .y = md_sub(md_neg(md_mul(_->s, m_mul(x, z, k))), y[k]),
+        .z = md_add(md_mul(_->s, m_mul(x, y, k)), m_const(_->v, k))
+    };
+}
@@ -1,6 +1,8 @@
 /*
  * Burke & Shaw System - http://www.atomosyd.net/spip.php?article33
  *
+ * Generated by tsm-compile.py from tsm-burke-shaw.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
@@ -9,9 +11,10 @@
 
 struct Parameters { real s, v; };
 
-model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 10);
-    model *_ = malloc(sizeof (model)); CHECK(_);
+    arena a = tsm_arena(sizeof (model), 0, n);
+    model *_ = tsm_take(&a, sizeof (model));
     tsm_get_p(argv, argc, &_->s, &_->v);
     return _;
 }
@@ -20,6 +23,44 @@ triplet ode (series x, series y, series z, const model *_, const int k) {
     return (triplet) {
         .x = - _->s * (x[k] + y[k]),
         .y = - _->s * t_mul(x, z, k) - y[k],
-        .z =   _->s * t_mul(x, y, k) + t_const(_->v, k)
+        .z = _->s * t_mul(x, y, k) + t_const(_->v, k)
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    return (triplet) {
+        .x = - _->s * (dx[k] + dy[k]),
+        .y = - _->s * (t_mul(z, dx, k) + t_mul(x, dz, k)) - dy[k],
+        .z = _->s * (t_mul(y, dx, k) + t_mul(x, dy, k))
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = - x[k] - y[k],
+            .y = - t_mul(x, z, k),
+            .z = t_mul(x, y, k)
+        };
+    case 1:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = t_const(RL(1.0), k)
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n;
+    for (int m = 0; m < n; m++) {
+        vx[m] = - _->s * (x[m] + y[m]);
+        vy[m] = - y[m];
+        vz[m] = t_const(_->v, k);
+    }
+    e_mul(vy, - _->s, e->x, e->z, k, n);
+    e_mul(vz, _->s, e->x, e->y, k, n);
+}
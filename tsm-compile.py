@@ -0,0 +1,971 @@
+#!/usr/bin/env python3
+#
+#  Model compiler, one declarative .ode file generates tsm-<model>.c, tsm-<model>-bc and tsm-<model>-md.c
+#
+#  Example: ./tsm-compile.py tsm-lorenz.ode
+#
+#  (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+from sys import argv, stderr, exit
+from os import chmod
+from decimal import Decimal
+import re
+
+PAIRS = {'sin': ('sin', 'cos', True), 'cos': ('sin', 'cos', True), 'sinh': ('sinh', 'cosh', False), 'cosh': ('sinh', 'cosh', False),
+         'tan': ('tan', 'sec2', True), 'sec2': ('tan', 'sec2', True), 'tanh': ('tanh', 'sech2', False), 'sech2': ('tanh', 'sech2', False)}
+FUNCTIONS = ('exp', 'sin', 'cos', 'sinh', 'cosh', 'tan', 'tanh', 'abs')
+BC_RESERVED = ('k', 'x', 'y', 'z', 'n', 'h', 'scale', 'ibase', 'obase', 'last', 'length', 'sqrt', 'read', 'define', 'auto',
+               'if', 'else', 'for', 'while', 'break', 'continue', 'return', 'quit', 'halt', 'print', 'void')
+
+def fail(message):
+    print(f'\033[1;31m{message}\033[0m', file=stderr)
+    exit(1)
+
+#  Constants (numbers, parameters and their combinations), as tuples
+
+def num(text):
+    return ('num', Decimal(text))
+
+def is_num(c, value=None):
+    return c[0] == 'num' and (value is None or c[1] == value)
+
+def c_neg(a):
+    if is_num(a):
+        return ('num', - a[1])
+    return a[1] if a[0] == 'neg' else ('neg', a)
+
+def c_add(a, b):
+    if is_num(a) and is_num(b):
+        return ('num', a[1] + b[1])
+    if is_num(a, 0):
+        return b
+    if is_num(b, 0):
+        return a
+    return ('add', a, b)
+
+def c_mul(a, b):
+    if is_num(a) and is_num(b):
+        return ('num', a[1] * b[1])
+    if is_num(a, 1):
+        return b
+    if is_num(b, 1):
+        return a
+    if is_num(a, -1):
+        return c_neg(b)
+    if is_num(b, -1):
+        return c_neg(a)
+    if negative(a):
+        return c_neg(c_mul(c_neg(a), b))
+    if negative(b):
+        return c_neg(c_mul(a, c_neg(b)))
+    return ('mul', b, a) if is_num(b) and not is_num(a) else ('mul', a, b)
+
+def c_div(a, b):
+    if is_num(b, 0):
+        fail('Division by zero')
+    if is_num(a) and is_num(b) and (a[1] / b[1]) * b[1] == a[1]:
+        return ('num', a[1] / b[1])
+    if a[0] == 'neg':
+        return c_neg(c_div(a[1], b))
+    return ('div', a, b)
+
+def negative(c):
+    return c[0] == 'neg' or (is_num(c) and c[1] < 0)
+
+def c_print(c, par, number, sgn, level=0):  # level: 0 sum, 1 product, 2 operand
+    kind = c[0]
+    if kind == 'num':
+        return number(c[1])
+    if kind == 'par':
+        return par(c[1])
+    if kind == 'sgn':
+        return sgn(c[1])
+    if kind == 'neg':
+        s = f'- {c_print(c[1], par, number, sgn, 1)}'
+        return f'({s})' if level else s
+    if kind == 'add':
+        b = c[2]
+        s = f'{c_print(c[1], par, number, sgn)} - {c_print(c_neg(b), par, number, sgn, 1)}' if negative(b) else \
+            f'{c_print(c[1], par, number, sgn)} + {c_print(b, par, number, sgn, 1)}'
+        return f'({s})' if level else s
+    s = f'{c_print(c[1], par, number, sgn, 1)} {"*" if kind == "mul" else "/"} {c_print(c[2], par, number, sgn, 2)}'
+    return f'({s})' if level > 1 else s
+
+def c_nodes(c):  # series nodes referred to by sgn() coefficients
+    if c[0] == 'sgn':
+        return [c[1]]
+    return [n for a in c[1:] if isinstance(a, tuple) for n in c_nodes(a)]
+
+#  Series nodes (interned, so structurally equal expressions are shared) and linear forms over them
+
+class Node:
+    table = {}
+    count = 0
+
+    def __init__(self, kind, args, name=None):
+        self.kind, self.args, self.name = kind, args, name
+        Node.count += 1
+        self.id = Node.count
+
+    def __repr__(self):
+        return self.name or f'{self.kind}{self.id}'
+
+def node(kind, *args, key=None):
+    key = (kind,) + (key if key is not None else args)
+    if key not in Node.table:
+        Node.table[key] = Node(kind, args, args[0] if kind == 'var' else None)
+    return Node.table[key]
+
+ONE = node('one')
+
+def lin(*terms):  # list of [coefficient, node] pairs, in order of first appearance
+    _ = []
+    for c, t in terms:
+        for item in _:
+            if item[1] is t:
+                item[0] = c_add(item[0], c)
+                break
+        else:
+            _.append([c, t])
+    return [[c, t] for c, t in _ if not is_num(c, 0)]
+
+def l_scale(a, c):
+    return lin(*[(c_mul(c, ca), t) for ca, t in a])
+
+def l_key(a):
+    return tuple(sorted(((t.id, c) for c, t in a), key=str))
+
+def jet(a):
+    return node('jet', *((c, t) for c, t in a), key=l_key(a))
+
+def operand(a):  # a linear form as a single series, with a scalar factor
+    if len(a) == 1 and a[0][1] is not ONE:
+        return a[0]
+    if not a:
+        fail('Zero series operand')
+    if all(t is ONE for c, t in a):
+        fail('Constant operand where a series is needed')
+    return [('num', Decimal(1)), jet(a)]
+
+def l_mul(a, b):
+    ca, u = operand(a)
+    cb, v = operand(b)
+    if u is v:
+        return [[c_mul(ca, cb), node('sqr', u)]]
+    u, v = sorted((u, v), key=lambda n: n.id)
+    return [[c_mul(ca, cb), node('mul', u, v)]]
+
+def l_fn(f, a):
+    c, u = operand(a)
+    if not is_num(c, 1):
+        u = jet(a)
+    if f == 'abs':
+        return [[num(1), node('abs', u)]]
+    return [[num(1), node('fn', f, u)]]
+
+def derivative(a):  # tangent (variational) form, c * S * dv terms, where S is a state-only series (or ONE)
+    _ = []
+    for c, t in a:
+        for cd, S, dv in d_node(t):
+            for item in _:
+                if item[1] is S and item[2] is dv:
+                    item[0] = c_add(item[0], c_mul(c, cd))
+                    break
+            else:
+                _.append([c_mul(c, cd), S, dv])
+    return [x for x in _ if not is_num(x[0], 0)]
+
+def d_node(t):
+    kind = t.kind
+    if kind == 'one':
+        return []
+    if kind == 'var':
+        return [(num(1), ONE, node('var', 'd' + t.args[0]))]
+    if kind == 'jet':
+        return derivative(list(t.args))
+    if kind == 'mul':
+        u, v = t.args
+        return _prod(d_node(u), v) + _prod(d_node(v), u)
+    if kind == 'sqr':
+        u, = t.args
+        return [(c_mul(num(2), c), S, dv) for c, S, dv in _prod(d_node(u), u)]
+    if kind == 'abs':
+        u, = t.args
+        return [(c_mul(('sgn', u), c), S, dv) for c, S, dv in d_node(u)]
+    f, u = t.args
+    if f == 'exp':
+        return _prod(d_node(u), t)
+    s, c, trig = PAIRS[f]
+    if f == s:
+        return _prod(d_node(u), node('fn', c, u))
+    if f == 'cos':
+        return [(c_neg(k), S, dv) for k, S, dv in _prod(d_node(u), node('fn', s, u))]
+    if f == 'cosh':
+        return _prod(d_node(u), node('fn', s, u))
+    fail(f'No derivative for {f}')
+
+def _prod(a, v):  # (S * dv) * v = (S * v) * dv
+    return [(c, v if S is ONE else l_mul([[num(1), S]], [[num(1), v]])[0][1], dv) for c, S, dv in a]
+
+def deviation(t):
+    return t.kind == 'var' and t.args[0][0] == 'd' or any(deviation(o) for o in t.args if isinstance(o, Node))
+
+def tangent(a):  # one convolution per deviation component, with a state-only jet for its Jacobian entry
+    terms = derivative(a)
+    _ = []
+    for dv in sorted(set(dv for c, S, dv in terms), key=lambda n: n.name):
+        column = [(c, S) for c, S, d in terms if d is dv]
+        _ += [[c, dv] for c, S in column if S is ONE]
+        series = lin(*[(c, S) for c, S in column if S is not ONE])
+        if series:
+            _ += l_mul(series, [[num(1), dv]])
+    return _
+
+def c_diff(c, p, derived):  # d c / d p, through any derived parameters
+    kind = c[0]
+    if kind in ('num', 'sgn'):
+        return num(0)
+    if kind == 'par':
+        return num(1) if c[1] == p else (c_diff(derived[c[1]], p, derived) if c[1] in derived else num(0))
+    if kind == 'neg':
+        return c_neg(c_diff(c[1], p, derived))
+    a, b = c[1], c[2]
+    da, db = c_diff(a, p, derived), c_diff(b, p, derived)
+    if kind == 'add':
+        return c_add(da, db)
+    if kind == 'mul':
+        return c_add(num(0) if is_num(da, 0) else c_mul(da, b), num(0) if is_num(db, 0) else c_mul(a, db))
+    if is_num(db, 0):
+        return num(0) if is_num(da, 0) else c_div(da, b)
+    return c_div(c_add(num(0) if is_num(da, 0) else c_mul(da, b), c_neg(c_mul(a, db))), c_mul(b, b))
+
+def p_derivative(a, p, derived):  # parameter derivative of a linear form, state-only terms
+    _ = []
+    for c, t in a:
+        dc = c_diff(c, p, derived)
+        _ += [(dc, t)] if not is_num(dc, 0) else []
+        _ += [(c_mul(c, cd), S) for cd, S in p_node(t, p, derived)]
+    return lin(*_)
+
+def p_node(t, p, derived):
+    kind = t.kind
+    if kind in ('one', 'var'):
+        return []
+    if kind == 'jet':
+        return p_derivative(list(t.args), p, derived)
+    if kind == 'mul':
+        u, v = t.args
+        return lin(*[tuple(x) for x in l_times(p_node(u, p, derived), v) + l_times(p_node(v, p, derived), u)])
+    if kind == 'sqr':
+        u, = t.args
+        return l_scale(l_times(p_node(u, p, derived), u), num(2))
+    if kind == 'abs':
+        u, = t.args
+        return [[c_mul(('sgn', u), c), S] for c, S in p_node(u, p, derived)]
+    f, u = t.args
+    du = p_node(u, p, derived)
+    if not du:
+        return []
+    if f == 'exp':
+        return l_times(du, t)
+    s, c, trig = PAIRS[f]
+    if f == s:
+        return l_times(du, node('fn', c, u))
+    if f == 'cos':
+        return l_scale(l_times(du, node('fn', s, u)), num(-1))
+    if f == 'cosh':
+        return l_times(du, node('fn', s, u))
+    fail(f'No derivative for {f}')
+
+def l_times(a, v):  # linear form times the series v
+    ones = [(c, v) for c, S in a if S is ONE]
+    rest = lin(*[(c, S) for c, S in a if S is not ONE])
+    return lin(*(ones + ([tuple(x) for x in l_mul(rest, [[num(1), v]])] if rest else [])))
+
+#  Parser
+
+TOKENS = re.compile(r"\s*(?:(\d+\.?\d*(?:[eE][-+]?\d+)?|\.\d+(?:[eE][-+]?\d+)?)|([A-Za-z_][A-Za-z_0-9]*)|(.))")
+
+class Parser:
+    def __init__(self, text, scope):
+        self.tokens = [(m.group(1), m.group(2), m.group(3)) for m in TOKENS.finditer(text) if any(m.groups())]
+        self.i, self.scope = 0, scope
+
+    def peek(self):
+        return self.tokens[self.i] if self.i < len(self.tokens) else (None, None, None)
+
+    def take(self, op=None):
+        token = self.peek()
+        if op is not None and token[2] != op:
+            fail(f'Expected "{op}"')
+        self.i += 1
+        return token
+
+    def parse(self):
+        _ = self.expr()
+        if self.i != len(self.tokens):
+            fail(f'Unexpected "{"".join(t for t in self.peek() if t)}"')
+        return _
+
+    def expr(self):
+        _ = self.term()
+        while self.peek()[2] in ('+', '-'):
+            op = self.take()[2]
+            b = self.term()
+            _ = add(_, b if op == '+' else neg(b))
+        return _
+
+    def term(self):
+        _ = self.unary()
+        while self.peek()[2] in ('*', '/'):
+            op = self.take()[2]
+            b = self.unary()
+            _ = mul(_, b) if op == '*' else div(_, b)
+        return _
+
+    def unary(self):
+        if self.peek()[2] == '-':
+            self.take()
+            return neg(self.unary())
+        if self.peek()[2] == '+':
+            self.take()
+        return self.power()
+
+    def power(self):
+        _ = self.atom()
+        if self.peek()[2] == '^':
+            self.take()
+            n = self.take()[0]
+            if n is None or not n.isdigit() or int(n) < 1:
+                fail('Only positive integer powers are supported')
+            b = _
+            for i in range(int(n) - 1):
+                _ = mul(_, b)
+        return _
+
+    def atom(self):
+        number, name, op = self.take()
+        if number is not None:
+            return ('const', num(number))
+        if op == '(':
+            _ = self.expr()
+            self.take(')')
+            return _
+        if name is None:
+            fail(f'Unexpected "{op}"')
+        if self.peek()[2] == '(':
+            if name not in FUNCTIONS:
+                fail(f'Unknown function {name}()')
+            self.take()
+            a = self.expr()
+            self.take(')')
+            if a[0] == 'const':
+                fail(f'Constant argument to {name}(), use a parameter instead')
+            return ('series', l_fn(name, a[1]))
+        if name not in self.scope:
+            fail(f'Unknown name {name}')
+        return self.scope[name]
+
+def series(a):
+    return a[1] if a[0] == 'series' else [[a[1], ONE]]
+
+def add(a, b):
+    if a[0] == b[0] == 'const':
+        return ('const', c_add(a[1], b[1]))
+    return ('series', lin(*[tuple(x) for x in series(a) + series(b)]))
+
+def neg(a):
+    return ('const', c_neg(a[1])) if a[0] == 'const' else ('series', l_scale(a[1], num(-1)))
+
+def mul(a, b):
+    if a[0] == b[0] == 'const':
+        return ('const', c_mul(a[1], b[1]))
+    if a[0] == 'const':
+        return ('series', l_scale(b[1], a[1]))
+    if b[0] == 'const':
+        return ('series', l_scale(a[1], b[1]))
+    return ('series', l_mul(a[1], b[1]))
+
+def div(a, b):
+    if b[0] != 'const':
+        fail('Division by a series is not supported')
+    if a[0] == 'const':
+        return ('const', c_div(a[1], b[1]))
+    return ('series', lin(*[(c_div(c, b[1]), t) for c, t in a[1]]))
+
+#  Model file
+
+class Model:
+    def __init__(self, path):
+        self.title, self.parameters, self.derived, self.names = None, [], [], {}
+        scope = {v: ('series', [[num(1), node('var', v)]]) for v in ('x', 'y', 'z')}
+        self.ode = {}
+        for number, line in enumerate(open(path), 1):
+            text = line.split('#', 1)[1].strip() if line.lstrip().startswith('#') else None
+            if text is not None:
+                self.title = self.title or text
+                continue
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                if line.startswith('parameters '):
+                    for p in line.split()[1:]:
+                        if p in scope or not re.fullmatch(r'[a-z][a-z0-9_]*', p):
+                            fail(f'Bad parameter name {p}')
+                        self.parameters.append(p)
+                        scope[p] = ('const', ('par', p))
+                    continue
+                left, right = (s.strip() for s in line.split('=', 1))
+                value = Parser(right, scope).parse()
+                if left in ("x'", "y'", "z'"):
+                    self.ode[left[0]] = series(value)
+                elif re.fullmatch(r'[a-z][a-z0-9_]*', left) and left not in scope and left not in BC_RESERVED:
+                    if value[0] == 'const':
+                        self.derived.append((left, value[1]))
+                        scope[left] = ('const', ('par', left))
+                    else:
+                        scope[left] = value
+                        named = self._named(value[1])
+                        if named:
+                            self.names.setdefault(named, left)
+                else:
+                    fail(f'Bad definition "{left}"')
+            except SystemExit:
+                print(f'{path}:{number}: {line}', file=stderr)
+                raise
+        if sorted(self.ode) != ['x', 'y', 'z'] or not self.title:
+            fail(f'{path}: needs a # title line and all of x\', y\' and z\'')
+        self.tangent = {v: tangent(self.ode[v]) for v in 'xyz'}
+        for v in 'xyz':
+            self.ode[v] = self._fuse(self.ode[v])
+        self._allocate()
+        self._parametric()
+
+    def _named(self, a):
+        c, t = operand(a)
+        return t if is_num(c, 1) and t.kind != 'var' else None
+
+    def _fuse(self, a):  # c1 u v + c2 u w -> u (c1 v + c2 w), one convolution instead of two
+        while True:
+            uses = self._uses()
+            groups = {}
+            for c, t in a:
+                if t.kind == 'mul' and uses.get(t, 0) == 1:
+                    for u, v in (t.args, t.args[::-1]):
+                        groups.setdefault(u, []).append((c, t, v))
+            best = max(groups.items(), key=lambda g: len(g[1]), default=(None, []))
+            if len(best[1]) < 2:
+                return a
+            u, members = best
+            fused = l_mul([[num(1), u]], lin(*[(c, v) for c, t, v in members]))
+            gone = set(t for c, t, v in members)
+            position = min(i for i, (c, t) in enumerate(a) if t in gone)
+            rest = [x for x in a if x[1] not in gone]
+            a = rest[:position] + fused + rest[position:]
+
+    def _forms_all(self):
+        return list(self.ode.values()) + list(self.tangent.values())
+
+    def _uses(self):  # how many times each node is referred to, in forms or as an operand
+        uses, seen = {}, set()
+        def visit(t):
+            if t in seen:
+                return
+            seen.add(t)
+            for o in self._operands(t):
+                uses[o] = uses.get(o, 0) + 2  # operands need a jet
+                visit(o)
+            if t.kind == 'jet':
+                for c, s in t.args:
+                    uses[s] = uses.get(s, 0) + 1
+                    visit(s)
+        for f in self._forms_all():
+            for c, t in f:
+                uses[t] = uses.get(t, 0) + 1
+                visit(t)
+        return uses
+
+    def _operands(self, t):
+        if t.kind in ('mul', 'sqr', 'abs'):
+            return list(t.args)
+        if t.kind == 'fn':
+            return [t.args[1]]
+        if t.kind == 'jet':
+            return [n for c, s in t.args for n in c_nodes(c)]
+        return []
+
+    def _allocate(self):
+        uses = self._uses()
+        self.stored = set(t for t in uses if t.kind in ('jet', 'fn') or (t.kind in ('mul', 'sqr', 'abs') and uses[t] > 1 and
+                          not deviation(t)))  # tangent() is called for each deviation in turn, so those are never stored
+        for forms in (self.ode, self.tangent):
+            for f in forms.values():
+                for c, t in f:
+                    self.stored.update(c_nodes(c))
+        for t in list(self.stored):  # both halves of a pair are written together
+            if t.kind == 'fn' and t.args[0] in PAIRS:
+                s, c, trig = PAIRS[t.args[0]]
+                self.stored.update((node('fn', s, t.args[1]), node('fn', c, t.args[1])))
+        self.stored = set(t for t in self.stored if t.kind != 'var')
+        self.order = {'ode': [], 'tangent': []}
+        self.home, self.bc_home = {}, {}
+        for function, forms in (('ode', self.ode), ('tangent', self.tangent)):
+            for v in 'xyz':
+                for c, t in forms[v]:
+                    self._schedule(t, function, v)
+                    for s in c_nodes(c):
+                        self._schedule(s, function, v)
+        taken = set(self.parameters) | set(p for p, c in self.derived) | {'x', 'y', 'z', 'dx', 'dy', 'dz'}
+        for t in [t for f in ('ode', 'tangent') for t in self.order[f]]:
+            self._name(t, taken)
+
+    def _parametric(self):  # d(x', y', z')/dp for each parameter, with any series ode() does not already make
+        derived = dict(self.derived)
+        self.ode_p, self.order['ode_p'] = {}, {}
+        for p in self.parameters:
+            self.ode_p[p] = {v: p_derivative(self.ode[v], p, derived) for v in 'xyz'}
+            order = self.order['ode_p'][p] = []
+            for v in 'xyz':
+                for c, t in self.ode_p[p][v]:
+                    for s in [t] + c_nodes(c):
+                        self._need(s, order)
+        fresh = set(t for order in self.order['ode_p'].values() for t in order)
+        operands = set(o for t in fresh for o in self._operands(t) + ([s for c, s in t.args] if t.kind == 'jet' else []))
+        self.stored.update(t for t in fresh if t.kind in ('jet', 'fn') or t in operands)
+        for p in self.parameters:
+            self.order['ode_p'][p] = [t for t in self.order['ode_p'][p] if t in self.stored]
+        taken = set(self.parameters) | set(p for p, c in self.derived) | {'x', 'y', 'z', 'dx', 'dy', 'dz'}
+        taken |= set(t.name for t in self.home if t.name)
+        for t in [t for order in self.order['ode_p'].values() for t in order]:
+            self._name(t, taken)
+
+    def _need(self, t, order):
+        if t in self.home or t in order or t.kind in ('one', 'var'):
+            return
+        for o in self._operands(t) + ([s for c, s in t.args] if t.kind == 'jet' else []):
+            self._need(o, order)
+        order.append(t)
+
+    def _schedule(self, t, function, v):
+        if t in self.home:
+            return
+        for o in self._operands(t) + ([s for c, s in t.args] if t.kind == 'jet' else []):
+            self._schedule(o, function, v)
+        if t in self.stored:
+            if t.kind == 'fn' and t.args[0] in PAIRS:  # the pair is computed with whichever half comes first
+                s, c, trig = PAIRS[t.args[0]]
+                for half in (node('fn', s, t.args[1]), node('fn', c, t.args[1])):
+                    if half not in self.home:
+                        self.home[half], self.bc_home[half] = function, v
+                self.order[function].append(node('fn', s, t.args[1]))
+                return
+            self.order[function].append(t)
+        self.home[t], self.bc_home[t] = function, v
+
+    def _name(self, t, taken):
+        if t.name:
+            return
+        if t in self.names and self.names[t] not in taken:
+            t.name = self.names[t]
+        elif t.kind == 'fn':
+            s = t.args[1].name if t.args[1].kind == 'var' or t.args[1].name else None
+            t.name = f'{t.args[0]}_{s}' if s else None
+            if t.args[0] in PAIRS:
+                first, second, trig = PAIRS[t.args[0]]
+                partner = node('fn', second if t.args[0] == first else first, t.args[1])
+                if not partner.name and s:
+                    partner.name = f'{partner.args[0]}_{s}'
+                    taken.add(partner.name)
+        elif t.kind in ('mul', 'sqr') and all(a.kind == 'var' or a.name for a in t.args) and \
+                len(''.join(str(a) for a in t.args)) <= 6:
+            t.name = ''.join(str(a) for a in t.args) if t.kind == 'mul' else f'{t.args[0]}2'
+        if not t.name or t.name in taken:
+            i = 1
+            while f'j{i}' in taken:
+                i += 1
+            t.name = f'j{i}'
+        taken.add(t.name)
+        if t.kind == 'fn' and t.args[0] in PAIRS:
+            first, second, trig = PAIRS[t.args[0]]
+            partner = node('fn', second if t.args[0] == first else first, t.args[1])
+            self._name(partner, taken)
+
+#  c back end
+
+def c_number(d):
+    if d < 0:
+        return f'-{c_number(- d)}'
+    s = format(d, 'f') if abs(d.as_tuple().exponent) < 12 else str(d)
+    return f'RL({s if ("." in s or "e" in s.lower()) else s + ".0"})'
+
+class C:
+    def __init__(self, model):
+        self.m = model
+
+    def const(self, c, level=0):
+        return c_print(c, lambda p: f'_->{p}', c_number, lambda n: f'({self.ref(n)}[0] < RL(0.0) ? - RL(1.0) : RL(1.0))', level)
+
+    def ref(self, t):  # series name
+        return t.name if t.kind == 'var' else f'_->{t.name}'
+
+    def value(self, t):  # kth element
+        if t.kind == 'var' or t in self.m.stored:
+            return f'{self.ref(t)}[k]'
+        u = t.args
+        if t.kind == 'mul':
+            return f't_mul({self.ref(u[0])}, {self.ref(u[1])}, k)'
+        if t.kind == 'sqr':
+            return f't_sqr({self.ref(u[0])}, k)'
+        if t.kind == 'abs':
+            return f't_abs({self.ref(u[0])}, k)'
+        fail(f'Unstored {t.kind}')
+
+    def form(self, a, value=None, const=None):  # terms sharing a coefficient are grouped, c * (u + v)
+        value, const = value or self.value, const or (lambda c: f't_const({self.const(c)}, k)')
+        if not a:
+            return 'RL(0.0)'
+        groups = {}
+        for c, t in a:
+            size = c_neg(c) if negative(c) else c
+            if t is not ONE and not is_num(size, 1):
+                groups.setdefault(size, []).append(t)
+        _, done = '', set()
+        for c, t in a:
+            if t in done:
+                continue
+            minus = negative(c)
+            c = c_neg(c) if minus else c
+            if t is ONE:
+                s = const(c)
+            elif len(groups.get(c, [])) > 1:
+                members = [[d, u] for d, u in a if u in groups[c]]
+                minus = all(negative(d) for d, u in members)
+                inner = [[num(-1) if negative(d) != minus else num(1), u] for d, u in members]
+                s = f'{self.const(c, 1)} * ({C.form(self, inner, value, const)})'
+                done.update(groups[c])
+            else:
+                s = value(t) if is_num(c, 1) else f'{self.const(c, 1)} * {value(t)}'
+            _ += (f'- {s}' if minus else s) if not _ else (f' - {s}' if minus else f' + {s}')
+        return _
+
+    def statement(self, t):
+        if t.kind == 'fn':
+            f, u = t.args
+            if f == 'exp':
+                return f't_exp({self.ref(t)}, {self.ref(u)}, k);'
+            s, c, trig = PAIRS[f]
+            s, c = node('fn', s, u), node('fn', c, u)
+            call = 't_sin_cos' if PAIRS[f][0] in ('sin', 'sinh') else 't_tan_sec2'
+            return f'{call}({self.ref(s)}, {self.ref(c)}, {self.ref(u)}, k, {"true" if trig else "false"});'
+        if t.kind == 'jet':
+            return f'{self.ref(t)}[k] = {self.form(list(t.args))};'
+        stored, self.m.stored = self.m.stored, self.m.stored - {t}
+        _ = f'{self.ref(t)}[k] = {self.value(t)};'
+        self.m.stored = stored
+        return _
+
+    def unused(self, names, text):
+        return ''.join(f' (void){v};' for v in names if not re.search(rf'(?<![.\w]){v}\b', text))
+
+    def function(self, head, names, body):
+        text = '\n'.join(body)
+        return f'{head} {{{self.unused(names, text)}\n{text}\n}}\n'
+
+    def triplet(self, forms):
+        return ['    return (triplet) {'] + [f'        .{v} = {self.form(forms[v])}{"," if v != "z" else ""}' for v in 'xyz'] + ['    };']
+
+    def ensemble(self):
+        m, lanes, rows = self.m, [], []
+        def row(t):
+            return f'e->{t.name}' if t.kind == 'var' else f'_->{t.name}'
+        def lane(t):
+            if t.kind == 'var' or t in m.stored:
+                if t not in lanes:
+                    lanes.append(t)
+                return f'{t.name}[m]'
+            return None
+        def split(a, target):  # lane-wise linear part, and e_*() calls for the rest
+            linear, calls = [], []
+            for c, t in a:
+                if t is ONE or lane(t):
+                    linear.append([c, t])
+                    continue
+                u = t.args
+                if t.kind == 'mul':
+                    calls.append(f'e_mul({target}, {self.const(c)}, {row(u[0])}, {row(u[1])}, k, n);')
+                else:
+                    calls.append(f'e_{t.kind}({target}, {self.const(c)}, {row(u[0])}, k, n);')
+            return self.form(linear, value=lambda t: lane(t)), calls
+        blocks, loop, calls, pending = [], [], [], set()
+        def flush():
+            nonlocal loop, calls, pending
+            if len(loop) == 1:
+                blocks.append(f'    for (int m = 0; m < n; m++) {loop[0].strip()}')
+            elif loop:
+                blocks.append('    for (int m = 0; m < n; m++) {\n' + '\n'.join(loop) + '\n    }')
+            blocks.extend(f'    {c}' for c in calls)
+            loop, calls, pending = [], [], set()
+        for t in m.order['ode']:
+            needs = set(m._operands(t)) | (set(s for c, s in t.args) if t.kind == 'jet' else set())
+            if needs & pending:
+                flush()
+            if t.kind == 'fn':
+                f, u = t.args
+                if f == 'exp':
+                    calls.append(f'e_exp({row(t)}, {row(u)}, k, n);')
+                else:
+                    s, c, trig = PAIRS[f]
+                    call = 'e_sin_cos' if s in ('sin', 'sinh') else 'e_tan_sec2'
+                    calls.append(f'{call}({row(node("fn", s, u))}, {row(node("fn", c, u))}, {row(u)}, k, n, {"true" if trig else "false"});')
+                pending.add(t)
+                if t.args[0] in PAIRS:
+                    pending.add(node('fn', PAIRS[f][1], u))
+                continue
+            a = list(t.args) if t.kind == 'jet' else [[num(1), t]]
+            if t.kind != 'jet':
+                stored, m.stored = m.stored, m.stored - {t}
+            linear, extra = split(a, f'{t.name}')
+            if t.kind != 'jet':
+                m.stored = stored
+            lane(t)
+            loop.append(f'        {t.name}[m] = {linear};')
+            calls.extend(extra)
+            if extra:
+                pending.add(t)
+        needs = set(t for v in 'xyz' for c, t in m.ode[v])
+        needs |= set(o for t in needs if t not in m.stored for o in m._operands(t))
+        if needs & pending:
+            flush()
+        for v in 'xyz':
+            linear, extra = split(m.ode[v], f'v{v}')
+            loop.append(f'        v{v}[m] = {linear};')
+            calls.extend(extra)
+        flush()
+        body = ['    const int n = e->n;']
+        variables = sorted((t for t in lanes if t.kind == 'var'), key=str)
+        for group in (variables, [t for t in lanes if t not in variables]):
+            if group:
+                body.append(f'    const series {", ".join(f"{t.name} = {row(t)} + k * n" for t in group)};')
+        body += blocks
+        return self.function('void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k)', ['_'], body)
+
+    def source(self, ode_file):
+        m = self.m
+        jets = []
+        extra = []
+        for order in m.order['ode_p'].values():
+            extra += [t for t in order if t not in extra]
+        for t in m.order['ode'] + m.order['tangent'] + extra:
+            jets += [t] + ([node('fn', PAIRS[t.args[0]][1], t.args[1])] if t.kind == 'fn' and t.args[0] in PAIRS else [])
+        reals = m.parameters + [p for p, c in m.derived]
+        fields = f'real {", ".join(reals)};' if reals else ''
+        fields += (' ' if fields and jets else '') + (f'series {", ".join(t.name for t in jets)};' if jets else '')
+        init = [f'    CHECK(argc == {8 + len(m.parameters)});', f'    arena a = tsm_arena(sizeof (model), {len(jets)}, n);',
+                '    model *_ = tsm_take(&a, sizeof (model));']
+        init += [f'    _->{t.name} = tsm_arena_jet(&a, n);' for t in jets]  # in the order ode(), tangent() and ode_p() use them
+        if m.parameters:
+            init.append(f'    tsm_get_p(argv, argc, {", ".join("&_->" + p for p in m.parameters)});')
+        init += [f'    _->{p} = {self.const(c)};' for p, c in m.derived] + ['    return _;']
+        ode = [f'    {self.statement(t)}' for t in m.order['ode']] + self.triplet(m.ode)
+        tangent = [f'    {self.statement(t)}' for t in m.order['tangent']] + self.triplet(m.tangent)
+        ode_p = ['    switch (i) {']
+        for i, p in enumerate(m.parameters):
+            body = [f'    {self.statement(t)}' for t in m.order['ode_p'][p]] + self.triplet(m.ode_p[p])
+            ode_p += [f'    case {i}:'] + [f'    {line}' for line in body]
+        ode_p += ['    }', '    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};']
+        return '\n'.join([
+            '/*', f' * {m.title}', ' *', f' * Generated by tsm-compile.py from {ode_file}, edit that instead', ' *',
+            ' * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file', ' */',
+            '#include <stdio.h>', '#include <stdlib.h>', '#include "taylor-ode.h"', '',
+            f'struct Parameters {{ {fields} }};' if fields else 'struct Parameters { real unused; };', '',
+            self.function('model *tsm_init_p (int argc, char **argv, int n)', ['n', 'argv'], init),
+            self.function('triplet ode (series x, series y, series z, const model *_, const int k)', ['x', 'y', 'z', '_'], ode),
+            self.function('triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k)',
+                          ['dx', 'dy', 'dz', 'x', 'y', 'z', '_'], tangent),
+            self.function('triplet ode_p (series x, series y, series z, const model *_, const int i, const int k)',
+                          ['x', 'y', 'z', '_', 'k'], ode_p),
+            self.ensemble()])
+
+#  multi-double back end, every coefficient that is not a parameter or a small number is worked out once in tsm_init_p()
+
+def md_number(d):
+    s = format(d, 'f') if abs(d.as_tuple().exponent) < 12 else str(d)
+    return s if ('.' in s or 'e' in s.lower()) else s + '.0'
+
+def exact(d):  # representable as a double, so md_d() and md_mul_d() are exact
+    return Decimal(float(d)) == d
+
+class Md(C):
+    def __init__(self, model):
+        C.__init__(self, model)
+        self.constants, self.jets = {}, []
+
+    def const(self, c, level=0):  # md expression, for tsm_init_p()
+        kind = c[0]
+        if kind == 'num':
+            return f'md_d({md_number(c[1])})' if exact(c[1]) else f'md_str("{md_number(c[1])}")'
+        if kind == 'par':
+            return f'_->{c[1]}'
+        if kind == 'sgn':
+            fail('sgn() in the multi-double ode()')
+        if kind == 'neg':
+            return f'md_neg({self.const(c[1])})'
+        return f'md_{kind}({self.const(c[1])}, {self.const(c[2])})'
+
+    def coefficient(self, c):  # a field holding c
+        if c[0] == 'par':
+            return f'_->{c[1]}'
+        if c not in self.constants:
+            taken = set(self.m.parameters) | set(p for p, d in self.m.derived) | set(t.name for t in self.jets)
+            i = len(self.constants) + 1
+            while f'c{i}' in taken:
+                i += 1
+            self.constants[c] = f'c{i}'
+        return f'_->{self.constants[c]}'
+
+    def scaled(self, c, v):
+        if is_num(c, 1):
+            return v
+        return f'md_mul_d({v}, {md_number(c[1])})' if is_num(c) and exact(c[1]) else f'md_mul({self.coefficient(c)}, {v})'
+
+    def value(self, t):
+        if t.kind == 'var' or t in self.m.stored:
+            return f'{self.ref(t)}[k]'
+        u = t.args
+        if t.kind == 'mul':
+            return f'm_mul({self.ref(u[0])}, {self.ref(u[1])}, k)'
+        if t.kind == 'sqr':
+            return f'm_sqr({self.ref(u[0])}, k)'
+        if t.kind == 'abs':
+            return f'm_abs({self.ref(u[0])}, k)'
+        fail(f'Unstored {t.kind}')
+
+    def form(self, a):  # as C.form(), c * (u + v) for terms sharing a coefficient
+        if not a:
+            return 'md_d(0.0)'
+        groups = {}
+        for c, t in a:
+            size = c_neg(c) if negative(c) else c
+            if t is not ONE and not is_num(size, 1):
+                groups.setdefault(size, []).append(t)
+        _, done = '', set()
+        for c, t in a:
+            if t in done:
+                continue
+            minus = negative(c)
+            c = c_neg(c) if minus else c
+            if t is ONE:
+                s = f'm_const({self.const(c) if is_num(c) and exact(c[1]) else self.coefficient(c)}, k)'
+            elif len(groups.get(c, [])) > 1:
+                members = [[d, u] for d, u in a if u in groups[c]]
+                minus = all(negative(d) for d, u in members)
+                s = self.scaled(c, self.form([[num(-1) if negative(d) != minus else num(1), u] for d, u in members]))
+                done.update(groups[c])
+            else:
+                s = self.scaled(c, self.value(t))
+            _ = (f'md_neg({s})' if minus else s) if not _ else (f'md_sub({_}, {s})' if minus else f'md_add({_}, {s})')
+        return _
+
+    def statement(self, t):
+        if t.kind == 'fn':
+            return C.statement(self, t).replace('t_', 'm_', 1)
+        if t.kind == 'jet':
+            return f'{self.ref(t)}[k] = {self.form(list(t.args))};'
+        stored, self.m.stored = self.m.stored, self.m.stored - {t}
+        _ = f'{self.ref(t)}[k] = {self.value(t)};'
+        self.m.stored = stored
+        return _
+
+    def source(self, ode_file):
+        m = self.m
+        for t in m.order['ode']:
+            self.jets += [t] + ([node('fn', PAIRS[t.args[0]][1], t.args[1])] if t.kind == 'fn' and t.args[0] in PAIRS else [])
+        ode = [f'    {self.statement(t)}' for t in m.order['ode']]
+        ode += ['    return (mtriplet) {'] + [f'        .{v} = {self.form(m.ode[v])}{"," if v != "z" else ""}' for v in 'xyz'] + ['    };']
+        mds = m.parameters + [p for p, c in m.derived] + list(self.constants.values())
+        fields = f'md {", ".join(mds)};' if mds else ''
+        fields += (' ' if fields and self.jets else '') + (f'mseries {", ".join(t.name for t in self.jets)};' if self.jets else '')
+        init = [f'    CHECK(argc == {8 + len(m.parameters)});', '    model *_ = malloc(sizeof (model)); CHECK(_);']
+        init += [f'    _->{t.name} = md_jet(n);' for t in self.jets]
+        if m.parameters:
+            init.append(f'    md_get_p(argv, argc, {", ".join("&_->" + p for p in m.parameters)});')
+        init += [f'    _->{p} = {self.const(c)};' for p, c in m.derived]
+        init += [f'    _->{name} = {self.const(c)};' for c, name in self.constants.items()] + ['    return _;']
+        return '\n'.join([
+            '/*', f' * {m.title}, multi-double', ' *', f' * Generated by tsm-compile.py from {ode_file}, edit that instead', ' *',
+            ' * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file', ' */',
+            '#include <stdio.h>', '#include <stdlib.h>', '#include "multi-double.h"', '',
+            f'struct Parameters {{ {fields} }};' if fields else 'struct Parameters { md unused; };', '',
+            self.function('model *tsm_init_p (int argc, char **argv, int n)', ['n', 'argv'], init),
+            self.function('mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k)', ['x', 'y', 'z', '_'], ode)])
+
+#  bc back end
+
+def bc_number(d):
+    s = format(d.normalize(), 'f')
+    return s[1:] if s.startswith('0.') else s
+
+class Bc:
+    def __init__(self, model, ode_file):
+        self.m, self.file = model, ode_file
+        self.names = {p: (p + '_' if p in BC_RESERVED else p) for p in model.parameters + [p for p, c in model.derived]}
+
+    def const(self, c, level=0):
+        return c_print(c, lambda p: self.names[p], bc_number, lambda n: fail('sgn() in bc'), level)
+
+    def value(self, t):
+        if t.kind == 'var' or t in self.m.stored:
+            return f'{t.name}[k]'
+        u = t.args
+        if t.kind == 'mul':
+            return f'mul({u[0].name}[], {u[1].name}[])'
+        return f'{t.kind}({u[0].name}[])'
+
+    def form(self, a):
+        return C.form(self, a, value=self.value, const=lambda c: f'const({self.const(c)})')
+
+    def statement(self, t):
+        if t.kind == 'fn':
+            f, u = t.args
+            if f == 'exp':
+                return f'exp({t.name}[], {u.name}[])'
+            s, c, trig = PAIRS[f]
+            call = 'sincos' if s in ('sin', 'sinh') else 'tansec2'
+            return f'{call}({node("fn", s, u).name}[], {node("fn", c, u).name}[], {u.name}[], {1 if trig else 0})'
+        if t.kind == 'jet':
+            return f'{t.name}[k] = {self.form(list(t.args))}'
+        stored, self.m.stored = self.m.stored, self.m.stored - {t}
+        _ = f'{t.name}[k] = {self.value(t)}'
+        self.m.stored = stored
+        return _
+
+    def script(self):
+        m = self.m
+        functions = []
+        for v in 'xyz':
+            body = [f'    {self.statement(t)}' for t in m.order['ode'] if m.bc_home.get(t) == v]
+            functions += [f'define ode_{v} () {{'] + body + [f'    return {self.form(m.ode[v])}', '}', '']
+        values = ['scale = $1', 'x[0] = $5', 'y[0] = $6', 'z[0] = $7']
+        values += [f'{self.names[p]} = ${i + 8 if i < 2 else "{" + str(i + 8) + "}"}' for i, p in enumerate(m.parameters)]
+        values += [f'{self.names[p]} = {self.const(c)}' for p, c in m.derived]
+        library = any(t.kind == 'fn' for t in m.order['ode'])
+        return '\n'.join([
+            '#!/bin/sh', f'# {m.title}', f'#  Generated by tsm-compile.py from {self.file}, edit that instead',
+            '#  (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file', '',
+            '. ./base.sh', '', f'BC_LINE_LENGTH=0 /usr/bin/bc{" -l" if library else ""} taylor.bc << EOF'] +
+            functions + ['; '.join(values), 'tsm($2, $3, $4)', 'EOF', ''])
+
+if __name__ == '__main__':
+    if len(argv) != 2 or not argv[1].endswith('.ode'):
+        fail(f'Usage: {argv[0]} tsm-<model>.ode')
+    ode_file = argv[1].rsplit('/', 1)[-1]
+    base = ode_file[:-4]
+    model = Model(argv[1])
+    with open(f'{base}.c', 'w') as f:
+        f.write(C(model).source(ode_file))
+    with open(f'{base}-bc', 'w') as f:
+        f.write(Bc(model, ode_file).script())
+    chmod(f'{base}-bc', 0o755)
+    with open(f'{base}-md.c', 'w') as f:
+        f.write(Md(model).source(ode_file))
+    print(f'{base}.c {base}-bc {base}-md.c', file=stderr)
@@ -0,0 +1,27 @@
+/*
+ * Genesio-Tesi System - http://www.atomosyd.net/spip.php?article153, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-genesio-tesi.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a, b; };
+
+model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+    CHECK(argc == 10);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    md_get_p(argv, argc, &_->a, &_->b);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    return (mtriplet) {
+        .x = y[k],
+        .y = z[k],
+        .z = md_sub(md_sub(md_sub(md_neg(m_sqr(x, k)), x[k]), md_mul(_->b, y[k])), md_mul(_->a, z[k]))
+    };
+}
@@ -1,6 +1,8 @@
 /*
  * Genesio-Tesi System - http://www.atomosyd.net/spip.php?article153
  *
+ * Generated by tsm-compile.py from tsm-genesio-tesi.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
@@ -9,9 +11,10 @@
 
 struct Parameters { real a, b; };
 
-model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 10);
-    model *_ = malloc(sizeof (model)); CHECK(_);
+    arena a = tsm_arena(sizeof (model), 0, n);
+    model *_ = tsm_take(&a, sizeof (model));
     tsm_get_p(argv, argc, &_->a, &_->b);
     return _;
 }
@@ -23,3 +26,40 @@ triplet ode (series x, series y, series z, const model *_, const int k) {
         .z = - t_sqr(x, k) - x[k] - _->b * y[k] - _->a * z[k]
     };
 }
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) { (void)y; (void)z;
+    return (triplet) {
+        .x = dy[k],
+        .y = dz[k],
+        .z = - dx[k] - RL(2.0) * t_mul(x, dx, k) - _->b * dy[k] - _->a * dz[k]
+    };
+}
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)x; (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - z[k]
+        };
+    case 1:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - y[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    for (int m = 0; m < n; m++) {
+        vx[m] = y[m];
+        vy[m] = z[m];
+        vz[m] = - x[m] - _->b * y[m] - _->a * z[m];
+    }
+    e_sqr(vz, -RL(1.0), e->x, k, n);
+}
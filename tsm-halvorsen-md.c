@@ -0,0 +1,27 @@
+/*
+ * Halvorsen Cyclic Attractor, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-halvorsen.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a; };
+
+model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+    CHECK(argc == 9);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    md_get_p(argv, argc, &_->a);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    return (mtriplet) {
+        .x = md_sub(md_sub(md_neg(md_mul(_->a, x[k])), md_mul_d(md_add(y[k], z[k]), 4.0)), m_sqr(y, k)),
+        .y = md_sub(md_sub(md_neg(md_mul(_->a, y[k])), md_mul_d(md_add(z[k], x[k]), 4.0)), m_sqr(z, k)),
+        .z = md_sub(md_sub(md_neg(md_mul(_->a, z[k])), md_mul_d(md_add(x[k], y[k]), 4.0)), m_sqr(x, k))
+    };
+}
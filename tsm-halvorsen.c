@@ -1,6 +1,8 @@
 /*
  * Halvorsen Cyclic Attractor
  *
+ * Generated by tsm-compile.py from tsm-halvorsen.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
@@ -9,17 +11,51 @@
 
 struct Parameters { real a; };
 
-model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 9);
-    model *_ = malloc(sizeof (model)); CHECK(_);
+    arena a = tsm_arena(sizeof (model), 0, n);
+    model *_ = tsm_take(&a, sizeof (model));
     tsm_get_p(argv, argc, &_->a);
     return _;
 }
 
 triplet ode (series x, series y, series z, const model *_, const int k) {
     return (triplet) {
-        .x = - _->a * x[k] - 4.0L * (y[k] + z[k]) - t_sqr(y, k),
-        .y = - _->a * y[k] - 4.0L * (z[k] + x[k]) - t_sqr(z, k),
-        .z = - _->a * z[k] - 4.0L * (x[k] + y[k]) - t_sqr(x, k)
+        .x = - _->a * x[k] - RL(4.0) * (y[k] + z[k]) - t_sqr(y, k),
+        .y = - _->a * y[k] - RL(4.0) * (z[k] + x[k]) - t_sqr(z, k),
+        .z = - _->a * z[k] - RL(4.0) * (x[k] + y[k]) - t_sqr(x, k)
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    return (triplet) {
+        .x = - _->a * dx[k] - RL(4.0) * (dy[k] + dz[k]) - RL(2.0) * t_mul(y, dy, k),
+        .y = - RL(4.0) * (dx[k] + dz[k]) - _->a * dy[k] - RL(2.0) * t_mul(z, dz, k),
+        .z = - RL(4.0) * (dx[k] + dy[k]) - RL(2.0) * t_mul(x, dx, k) - _->a * dz[k]
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = - x[k],
+            .y = - y[k],
+            .z = - z[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    for (int m = 0; m < n; m++) {
+        vx[m] = - _->a * x[m] - RL(4.0) * (y[m] + z[m]);
+        vy[m] = - _->a * y[m] - RL(4.0) * (z[m] + x[m]);
+        vz[m] = - _->a * z[m] - RL(4.0) * (x[m] + y[m]);
+    }
+    e_sqr(vx, -RL(1.0), e->y, k, n);
+    e_sqr(vy, -RL(1.0), e->z, k, n);
+    e_sqr(vz, -RL(1.0), e->x, k, n);
+}
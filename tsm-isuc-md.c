@@ -0,0 +1,29 @@
+/*
+ * Inverted smooth unimodal chaos - http://www.atomosyd.net/spip.php?article218, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-isuc.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a, b, c; mseries x2py2; };
+
+model *tsm_init_p (int argc, char **argv, int n) {
+    CHECK(argc == 11);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->x2py2 = md_jet(n);
+    md_get_p(argv, argc, &_->a, &_->b, &_->c);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    _->x2py2[k] = md_add(m_sqr(x, k), m_sqr(y, k));
+    return (mtriplet) {
+        .x = md_sub(z[k], y[k]),
+        .y = md_sub(x[k], md_mul(_->a, y[k])),
+        .z = md_sub(md_add(m_const(_->b, k), md_mul(_->c, z[k])), m_mul(z, _->x2py2, k))
+    };
+}
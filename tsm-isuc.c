@@ -1,18 +1,23 @@
 /*
  * Inverted smooth unimodal chaos - http://www.atomosyd.net/spip.php?article218
  *
+ * Generated by tsm-compile.py from tsm-isuc.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real a, b, c; series x2py2; };
+struct Parameters { real a, b, c; series x2py2, xz, yz; };
 
 model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 11);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    _->x2py2 = tsm_jet(n);
+    arena a = tsm_arena(sizeof (model), 3, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->x2py2 = tsm_arena_jet(&a, n);
+    _->xz = tsm_arena_jet(&a, n);
+    _->yz = tsm_arena_jet(&a, n);
     tsm_get_p(argv, argc, &_->a, &_->b, &_->c);
     return _;
 }
@@ -22,6 +27,55 @@ triplet ode (series x, series y, series z, const model *_, const int k) {
     return (triplet) {
         .x = z[k] - y[k],
         .y = x[k] - _->a * y[k],
-        .z = t_const(_->b, k) + _->c * z[k] - t_mul(_->x2py2, z, k)
+        .z = t_const(_->b, k) + _->c * z[k] - t_mul(z, _->x2py2, k)
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    _->xz[k] = t_mul(x, z, k);
+    _->yz[k] = t_mul(y, z, k);
+    return (triplet) {
+        .x = - dy[k] + dz[k],
+        .y = dx[k] - _->a * dy[k],
+        .z = - RL(2.0) * (t_mul(dx, _->xz, k) + t_mul(dy, _->yz, k)) + _->c * dz[k] - t_mul(_->x2py2, dz, k)
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)x; (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = - y[k],
+            .z = RL(0.0)
+        };
+    case 1:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = t_const(RL(1.0), k)
+        };
+    case 2:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = z[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    const series x2py2 = _->x2py2 + k * n;
+    for (int m = 0; m < n; m++) x2py2[m] = RL(0.0);
+    e_sqr(x2py2, RL(1.0), e->x, k, n);
+    e_sqr(x2py2, RL(1.0), e->y, k, n);
+    for (int m = 0; m < n; m++) {
+        vx[m] = z[m] - y[m];
+        vy[m] = x[m] - _->a * y[m];
+        vz[m] = t_const(_->b, k) + _->c * z[m];
+    }
+    e_mul(vz, -RL(1.0), e->z, _->x2py2, k, n);
+}
@@ -0,0 +1,28 @@
+/*
+ * Lorenz System, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-lorenz.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md sigma, rho, b, d, beta; };
+
+model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+    CHECK(argc == 12);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    md_get_p(argv, argc, &_->sigma, &_->rho, &_->b, &_->d);
+    _->beta = md_div(_->b, _->d);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    return (mtriplet) {
+        .x = md_mul(_->sigma, md_sub(y[k], x[k])),
+        .y = md_sub(md_sub(md_mul(_->rho, x[k]), y[k]), m_mul(x, z, k)),
+        .z = md_sub(m_mul(x, y, k), md_mul(_->beta, z[k]))
+    };
+}
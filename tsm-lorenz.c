@@ -1,20 +1,22 @@
 /*
  * Lorenz System
  *
+ * Generated by tsm-compile.py from tsm-lorenz.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real sigma, rho, beta; };
+struct Parameters { real sigma, rho, b, d, beta; };
 
-model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 12);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    real d;
-    tsm_get_p(argv, argc, &_->sigma, &_->rho, &_->beta, &d);
-    _->beta /= d;
+    arena a = tsm_arena(sizeof (model), 0, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    tsm_get_p(argv, argc, &_->sigma, &_->rho, &_->b, &_->d);
+    _->beta = _->b / _->d;
     return _;
 }
 
@@ -25,3 +27,53 @@ triplet ode (series x, series y, series z, const model *_, const int k) {
         .z = t_mul(x, y, k) - _->beta * z[k]
     };
 }
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    return (triplet) {
+        .x = _->sigma * (- dx[k] + dy[k]),
+        .y = _->rho * dx[k] - t_mul(z, dx, k) - dy[k] - t_mul(x, dz, k),
+        .z = t_mul(y, dx, k) + t_mul(x, dy, k) - _->beta * dz[k]
+    };
+}
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) {
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = y[k] - x[k],
+            .y = RL(0.0),
+            .z = RL(0.0)
+        };
+    case 1:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = x[k],
+            .z = RL(0.0)
+        };
+    case 2:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - RL(1.0) / _->d * z[k]
+        };
+    case 3:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = _->b / (_->d * _->d) * z[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    for (int m = 0; m < n; m++) {
+        vx[m] = _->sigma * (y[m] - x[m]);
+        vy[m] = _->rho * x[m] - y[m];
+        vz[m] = - _->beta * z[m];
+    }
+    e_mul(vy, -RL(1.0), e->x, e->z, k, n);
+    e_mul(vz, RL(1.0), e->x, e->y, k, n);
+}
@@ -0,0 +1,37 @@
+/*
+ * Rabinovich–Fabrikant System, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-rf.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md alpha, gamma; mseries x2, a, j1, xy, j2; };
+
+model *tsm_init_p (int argc, char **argv, int n) {
+    CHECK(argc == 10);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->x2 = md_jet(n);
+    _->a = md_jet(n);
+    _->j1 = md_jet(n);
+    _->xy = md_jet(n);
+    _->j2 = md_jet(n);
+    md_get_p(argv, argc, &_->alpha, &_->gamma);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    _->x2[k] = m_sqr(x, k);
+    _->a[k] = md_sub(md_add(z[k], _->x2[k]), m_const(md_d(1.0), k));
+    _->j1[k] = md_add(md_sub(md_mul_d(z[k], 3.0), _->x2[k]), m_const(md_d(1.0), k));
+    _->xy[k] = m_mul(x, y, k);
+    _->j2[k] = md_add(m_const(_->alpha, k), _->xy[k]);
+    return (mtriplet) {
+        .x = md_add(m_mul(y, _->a, k), md_mul(_->gamma, x[k])),
+        .y = md_add(m_mul(x, _->j1, k), md_mul(_->gamma, y[k])),
+        .z = md_neg(md_mul_d(m_mul(z, _->j2, k), 2.0))
+    };
+}
@@ -1,31 +1,93 @@
 /*
  * Rabinovich–Fabrikant System
  *
+ * Generated by tsm-compile.py from tsm-rf.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real alpha, gamma; series _a, _b, _c; };
+struct Parameters { real alpha, gamma; series x2, a, j1, xy, j2, j3, yz, xz; };
 
 model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 10);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    _->_a = tsm_jet(n);
-    _->_b = tsm_jet(n);
-    _->_c = tsm_jet(n);
+    arena a = tsm_arena(sizeof (model), 8, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->x2 = tsm_arena_jet(&a, n);
+    _->a = tsm_arena_jet(&a, n);
+    _->j1 = tsm_arena_jet(&a, n);
+    _->xy = tsm_arena_jet(&a, n);
+    _->j2 = tsm_arena_jet(&a, n);
+    _->j3 = tsm_arena_jet(&a, n);
+    _->yz = tsm_arena_jet(&a, n);
+    _->xz = tsm_arena_jet(&a, n);
     tsm_get_p(argv, argc, &_->alpha, &_->gamma);
     return _;
 }
 
 triplet ode (series x, series y, series z, const model *_, const int k) {
-    _->_a[k] = z[k] + t_sqr(x, k) - t_const(1.0L, k);
-    _->_b[k] = 4.0L * z[k] - _->_a[k];
-    _->_c[k] = t_const(_->alpha, k) + t_mul(x, y, k);
+    _->x2[k] = t_sqr(x, k);
+    _->a[k] = z[k] + _->x2[k] - t_const(RL(1.0), k);
+    _->j1[k] = RL(3.0) * z[k] - _->x2[k] + t_const(RL(1.0), k);
+    _->xy[k] = t_mul(x, y, k);
+    _->j2[k] = t_const(_->alpha, k) + _->xy[k];
+    return (triplet) {
+        .x = t_mul(y, _->a, k) + _->gamma * x[k],
+        .y = t_mul(x, _->j1, k) + _->gamma * y[k],
+        .z = - RL(2.0) * t_mul(z, _->j2, k)
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    _->j3[k] = _->j1[k] - RL(2.0) * _->x2[k];
+    _->yz[k] = t_mul(y, z, k);
+    _->xz[k] = t_mul(x, z, k);
     return (triplet) {
-        .x = t_mul(y, _->_a, k) + _->gamma * x[k],
-        .y = t_mul(x, _->_b, k) + _->gamma * y[k],
-        .z = - 2.0L * t_mul(z, _->_c, k)
+        .x = _->gamma * dx[k] + RL(2.0) * t_mul(_->xy, dx, k) + t_mul(_->a, dy, k) + t_mul(y, dz, k),
+        .y = t_mul(dx, _->j3, k) + _->gamma * dy[k] + RL(3.0) * t_mul(x, dz, k),
+        .z = - RL(2.0) * (t_mul(dx, _->yz, k) + t_mul(dy, _->xz, k) + t_mul(_->j2, dz, k))
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - RL(2.0) * z[k]
+        };
+    case 1:
+        return (triplet) {
+            .x = x[k],
+            .y = y[k],
+            .z = RL(0.0)
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    const series x2 = _->x2 + k * n, a = _->a + k * n, j1 = _->j1 + k * n, xy = _->xy + k * n, j2 = _->j2 + k * n;
+    for (int m = 0; m < n; m++) x2[m] = RL(0.0);
+    e_sqr(x2, RL(1.0), e->x, k, n);
+    for (int m = 0; m < n; m++) {
+        a[m] = z[m] + x2[m] - t_const(RL(1.0), k);
+        j1[m] = RL(3.0) * z[m] - x2[m] + t_const(RL(1.0), k);
+        xy[m] = RL(0.0);
+    }
+    e_mul(xy, RL(1.0), e->x, e->y, k, n);
+    for (int m = 0; m < n; m++) {
+        j2[m] = t_const(_->alpha, k) + xy[m];
+        vx[m] = _->gamma * x[m];
+        vy[m] = _->gamma * y[m];
+        vz[m] = RL(0.0);
+    }
+    e_mul(vx, RL(1.0), e->y, _->a, k, n);
+    e_mul(vy, RL(1.0), e->x, _->j1, k, n);
+    e_mul(vz, -RL(2.0), e->z, _->j2, k, n);
+}
@@ -0,0 +1,27 @@
+/*
+ * Rossler System, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-rossler.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a, b, c; };
+
+model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+    CHECK(argc == 11);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    md_get_p(argv, argc, &_->a, &_->b, &_->c);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    return (mtriplet) {
+        .x = md_sub(md_neg(y[k]), z[k]),
+        .y = md_add(x[k], md_mul(_->a, y[k])),
+        .z = md_sub(md_add(m_const(_->b, k), m_mul(x, z, k)), md_mul(_->c, z[k]))
+    };
+}
@@ -1,6 +1,8 @@
 /*
  * Rossler System
  *
+ * Generated by tsm-compile.py from tsm-rossler.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
@@ -9,9 +11,10 @@
 
 struct Parameters { real a, b, c; };
 
-model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 11);
-    model *_ = malloc(sizeof (model)); CHECK(_);
+    arena a = tsm_arena(sizeof (model), 0, n);
+    model *_ = tsm_take(&a, sizeof (model));
     tsm_get_p(argv, argc, &_->a, &_->b, &_->c);
     return _;
 }
@@ -23,3 +26,46 @@ triplet ode (series x, series y, series z, const model *_, const int k) {
         .z = t_const(_->b, k) + t_mul(x, z, k) - _->c * z[k]
     };
 }
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) { (void)y;
+    return (triplet) {
+        .x = - dy[k] - dz[k],
+        .y = dx[k] + _->a * dy[k],
+        .z = t_mul(z, dx, k) - _->c * dz[k] + t_mul(x, dz, k)
+    };
+}
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)x; (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = y[k],
+            .z = RL(0.0)
+        };
+    case 1:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = t_const(RL(1.0), k)
+        };
+    case 2:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - z[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    for (int m = 0; m < n; m++) {
+        vx[m] = - y[m] - z[m];
+        vy[m] = x[m] + _->a * y[m];
+        vz[m] = t_const(_->b, k) - _->c * z[m];
+    }
+    e_mul(vz, RL(1.0), e->x, e->z, k, n);
+}
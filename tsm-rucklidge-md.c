@@ -0,0 +1,27 @@
+/*
+ * Rucklidge Attractor, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-rucklidge.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a, k; };
+
+model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+    CHECK(argc == 10);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    md_get_p(argv, argc, &_->a, &_->k);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    return (mtriplet) {
+        .x = md_sub(md_sub(md_mul(_->a, y[k]), md_mul(_->k, x[k])), m_mul(y, z, k)),
+        .y = x[k],
+        .z = md_sub(m_sqr(y, k), z[k])
+    };
+}
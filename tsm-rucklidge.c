@@ -1,6 +1,8 @@
 /*
  * Rucklidge Attractor
  *
+ * Generated by tsm-compile.py from tsm-rucklidge.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
@@ -9,17 +11,56 @@
 
 struct Parameters { real a, k; };
 
-model *tsm_init_p (int argc, char **argv, int n) { (void)n;
+model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 10);
-    model *_ = malloc(sizeof (model)); CHECK(_);
+    arena a = tsm_arena(sizeof (model), 0, n);
+    model *_ = tsm_take(&a, sizeof (model));
     tsm_get_p(argv, argc, &_->a, &_->k);
     return _;
 }
 
-triplet ode (series x, series y, series z, const model *_,  const int k) {
+triplet ode (series x, series y, series z, const model *_, const int k) {
     return (triplet) {
         .x = _->a * y[k] - _->k * x[k] - t_mul(y, z, k),
         .y = x[k],
         .z = t_sqr(y, k) - z[k]
     };
 }
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) { (void)x;
+    return (triplet) {
+        .x = - _->k * dx[k] + _->a * dy[k] - t_mul(z, dy, k) - t_mul(y, dz, k),
+        .y = dx[k],
+        .z = RL(2.0) * t_mul(y, dy, k) - dz[k]
+    };
+}
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)z; (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = y[k],
+            .y = RL(0.0),
+            .z = RL(0.0)
+        };
+    case 1:
+        return (triplet) {
+            .x = - x[k],
+            .y = RL(0.0),
+            .z = RL(0.0)
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    for (int m = 0; m < n; m++) {
+        vx[m] = _->a * y[m] - _->k * x[m];
+        vy[m] = x[m];
+        vz[m] = - z[m];
+    }
+    e_mul(vx, -RL(1.0), e->y, e->z, k, n);
+    e_sqr(vz, RL(1.0), e->y, k, n);
+}
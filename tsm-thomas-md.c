@@ -0,0 +1,36 @@
+/*
+ * Thomas' cyclically symmetric attractor, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-thomas.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md b; mseries sin_y, cos_y, sin_z, cos_z, sin_x, cos_x; };
+
+model *tsm_init_p (int argc, char **argv, int n) {
+    CHECK(argc == 9);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->sin_y = md_jet(n);
+    _->cos_y = md_jet(n);
+    _->sin_z = md_jet(n);
+    _->cos_z = md_jet(n);
+    _->sin_x = md_jet(n);
+    _->cos_x = md_jet(n);
+    md_get_p(argv, argc, &_->b);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    m_sin_cos(_->sin_y, _->cos_y, y, k, true);
+    m_sin_cos(_->sin_z, _->cos_z, z, k, true);
+    m_sin_cos(_->sin_x, _->cos_x, x, k, true);
+    return (mtriplet) {
+        .x = md_sub(_->sin_y[k], md_mul(_->b, x[k])),
+        .y = md_sub(_->sin_z[k], md_mul(_->b, y[k])),
+        .z = md_sub(_->sin_x[k], md_mul(_->b, z[k]))
+    };
+}
@@ -1,28 +1,71 @@
 /*
  * Thomas' cyclically symmetric attractor
  *
+ * Generated by tsm-compile.py from tsm-thomas.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real b; series sx, sy, sz, cx, cy, cz; };
+struct Parameters { real b; series sin_y, cos_y, sin_z, cos_z, sin_x, cos_x; };
 
 model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 9);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    _->sx = tsm_jet(n); _->cx = tsm_jet(n);
-    _->sy = tsm_jet(n); _->cy = tsm_jet(n);
-    _->sz = tsm_jet(n); _->cz = tsm_jet(n);
+    arena a = tsm_arena(sizeof (model), 6, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->sin_y = tsm_arena_jet(&a, n);
+    _->cos_y = tsm_arena_jet(&a, n);
+    _->sin_z = tsm_arena_jet(&a, n);
+    _->cos_z = tsm_arena_jet(&a, n);
+    _->sin_x = tsm_arena_jet(&a, n);
+    _->cos_x = tsm_arena_jet(&a, n);
     tsm_get_p(argv, argc, &_->b);
     return _;
 }
 
 triplet ode (series x, series y, series z, const model *_, const int k) {
+    t_sin_cos(_->sin_y, _->cos_y, y, k, true);
+    t_sin_cos(_->sin_z, _->cos_z, z, k, true);
+    t_sin_cos(_->sin_x, _->cos_x, x, k, true);
+    return (triplet) {
+        .x = _->sin_y[k] - _->b * x[k],
+        .y = _->sin_z[k] - _->b * y[k],
+        .z = _->sin_x[k] - _->b * z[k]
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) { (void)x; (void)y; (void)z;
     return (triplet) {
-        .x = t_sin_cos(_->sy, _->cy, y, k, true).a - _->b * x[k],
-        .y = t_sin_cos(_->sz, _->cz, z, k, true).a - _->b * y[k],
-        .z = t_sin_cos(_->sx, _->cx, x, k, true).a - _->b * z[k]
+        .x = - _->b * dx[k] + t_mul(dy, _->cos_y, k),
+        .y = - _->b * dy[k] + t_mul(dz, _->cos_z, k),
+        .z = t_mul(dx, _->cos_x, k) - _->b * dz[k]
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = - x[k],
+            .y = - y[k],
+            .z = - z[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    const series sin_y = _->sin_y + k * n, sin_z = _->sin_z + k * n, sin_x = _->sin_x + k * n;
+    e_sin_cos(_->sin_y, _->cos_y, e->y, k, n, true);
+    e_sin_cos(_->sin_z, _->cos_z, e->z, k, n, true);
+    e_sin_cos(_->sin_x, _->cos_x, e->x, k, n, true);
+    for (int m = 0; m < n; m++) {
+        vx[m] = sin_y[m] - _->b * x[m];
+        vy[m] = sin_z[m] - _->b * y[m];
+        vz[m] = sin_x[m] - _->b * z[m];
+    }
+}
@@ -0,0 +1,30 @@
+/*
+ * Wimol-Banlue System, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-wimol-banlue.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a; mseries tanh_x, sech2_x; };
+
+model *tsm_init_p (int argc, char **argv, int n) {
+    CHECK(argc == 9);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->tanh_x = md_jet(n);
+    _->sech2_x = md_jet(n);
+    md_get_p(argv, argc, &_->a);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    m_tan_sec2(_->tanh_x, _->sech2_x, x, k, false);
+    return (mtriplet) {
+        .x = md_sub(y[k], x[k]),
+        .y = md_neg(m_mul(z, _->tanh_x, k)),
+        .z = md_sub(md_add(m_mul(x, y, k), m_abs(y, k)), m_const(_->a, k))
+    };
+}
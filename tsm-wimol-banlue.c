@@ -1,28 +1,67 @@
 /*
  * Wimol-Banlue System
  *
+ * Generated by tsm-compile.py from tsm-wimol-banlue.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real a; series tx, sx; };
+struct Parameters { real a; series tanh_x, sech2_x, j1; };
 
 model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 9);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    _->tx = tsm_jet(n);
-    _->sx = tsm_jet(n);
+    arena a = tsm_arena(sizeof (model), 3, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->tanh_x = tsm_arena_jet(&a, n);
+    _->sech2_x = tsm_arena_jet(&a, n);
+    _->j1 = tsm_arena_jet(&a, n);
     tsm_get_p(argv, argc, &_->a);
     return _;
 }
 
 triplet ode (series x, series y, series z, const model *_, const int k) {
-    t_tan_sec2(_->tx, _->sx, x, k, false);
+    t_tan_sec2(_->tanh_x, _->sech2_x, x, k, false);
     return (triplet) {
         .x = y[k] - x[k],
-        .y = - t_mul(z, _->tx, k),
-        .z = - t_const(_->a, k) + t_mul(x, y, k) + t_abs(y, k)
+        .y = - t_mul(z, _->tanh_x, k),
+        .z = t_mul(x, y, k) + t_abs(y, k) - t_const(_->a, k)
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    _->j1[k] = t_mul(z, _->sech2_x, k);
+    return (triplet) {
+        .x = - dx[k] + dy[k],
+        .y = - t_mul(dx, _->j1, k) - t_mul(_->tanh_x, dz, k),
+        .z = t_mul(y, dx, k) + (y[0] < RL(0.0) ? - RL(1.0) : RL(1.0)) * dy[k] + t_mul(x, dy, k)
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)x; (void)y; (void)z; (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - t_const(RL(1.0), k)
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n;
+    e_tan_sec2(_->tanh_x, _->sech2_x, e->x, k, n, false);
+    for (int m = 0; m < n; m++) {
+        vx[m] = y[m] - x[m];
+        vy[m] = RL(0.0);
+        vz[m] = - t_const(_->a, k);
+    }
+    e_mul(vy, -RL(1.0), e->z, _->tanh_x, k, n);
+    e_mul(vz, RL(1.0), e->x, e->y, k, n);
+    e_abs(vz, RL(1.0), e->y, k, n);
+}
@@ -0,0 +1,31 @@
+/*
+ * Yu-Wang System, multi-double
+ *
+ * Generated by tsm-compile.py from tsm-yu-wang.ode, edit that instead
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "multi-double.h"
+
+struct Parameters { md a, b, c, d; mseries xy, exp_xy; };
+
+model *tsm_init_p (int argc, char **argv, int n) {
+    CHECK(argc == 12);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->xy = md_jet(n);
+    _->exp_xy = md_jet(n);
+    md_get_p(argv, argc, &_->a, &_->b, &_->c, &_->d);
+    return _;
+}
+
+mtriplet ode (mseries x, mseries y, mseries z, const model *_, const int k) {
+    _->xy[k] = m_mul(x, y, k);
+    m_exp(_->exp_xy, _->xy, k);
+    return (mtriplet) {
+        .x = md_mul(_->a, md_sub(y[k], x[k])),
+        .y = md_sub(md_mul(_->b, x[k]), md_mul(_->c, m_mul(x, z, k))),
+        .z = md_sub(_->exp_xy[k], md_mul(_->d, z[k]))
+    };
+}
@@ -1,28 +1,89 @@
 /*
  * Yu-Wang System
  *
+ * Generated by tsm-compile.py from tsm-yu-wang.ode, edit that instead
+ *
  * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
  */
 #include <stdio.h>
 #include <stdlib.h>
 #include "taylor-ode.h"
 
-struct Parameters { real a, b, c, d; series xy, e_xy; };
+struct Parameters { real a, b, c, d; series xy, exp_xy, j1, j2; };
 
 model *tsm_init_p (int argc, char **argv, int n) {
     CHECK(argc == 12);
-    model *_ = malloc(sizeof (model)); CHECK(_);
-    _->xy = tsm_jet(n);
-    _->e_xy = tsm_jet(n);
+    arena a = tsm_arena(sizeof (model), 4, n);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->xy = tsm_arena_jet(&a, n);
+    _->exp_xy = tsm_arena_jet(&a, n);
+    _->j1 = tsm_arena_jet(&a, n);
+    _->j2 = tsm_arena_jet(&a, n);
     tsm_get_p(argv, argc, &_->a, &_->b, &_->c, &_->d);
     return _;
 }
 
 triplet ode (series x, series y, series z, const model *_, const int k) {
     _->xy[k] = t_mul(x, y, k);
+    t_exp(_->exp_xy, _->xy, k);
     return (triplet) {
         .x = _->a * (y[k] - x[k]),
         .y = _->b * x[k] - _->c * t_mul(x, z, k),
-        .z = t_exp(_->e_xy, _->xy, k) - _->d * z[k]
+        .z = _->exp_xy[k] - _->d * z[k]
+    };
+}
+
+triplet tangent (series dx, series dy, series dz, series x, series y, series z, const model *_, const int k) {
+    _->j1[k] = t_mul(y, _->exp_xy, k);
+    _->j2[k] = t_mul(x, _->exp_xy, k);
+    return (triplet) {
+        .x = _->a * (- dx[k] + dy[k]),
+        .y = _->b * dx[k] - _->c * (t_mul(z, dx, k) + t_mul(x, dz, k)),
+        .z = t_mul(dx, _->j1, k) + t_mul(dy, _->j2, k) - _->d * dz[k]
     };
 }
+
+triplet ode_p (series x, series y, series z, const model *_, const int i, const int k) { (void)_;
+    switch (i) {
+    case 0:
+        return (triplet) {
+            .x = y[k] - x[k],
+            .y = RL(0.0),
+            .z = RL(0.0)
+        };
+    case 1:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = x[k],
+            .z = RL(0.0)
+        };
+    case 2:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = - t_mul(x, z, k),
+            .z = RL(0.0)
+        };
+    case 3:
+        return (triplet) {
+            .x = RL(0.0),
+            .y = RL(0.0),
+            .z = - z[k]
+        };
+    }
+    return (triplet) {RL(0.0), RL(0.0), RL(0.0)};
+}
+
+void ode_e (series vx, series vy, series vz, const ensemble *e, const model *_, const int k) {
+    const int n = e->n;
+    const series x = e->x + k * n, y = e->y + k * n, z = e->z + k * n;
+    const series xy = _->xy + k * n, exp_xy = _->exp_xy + k * n;
+    for (int m = 0; m < n; m++) xy[m] = RL(0.0);
+    e_mul(xy, RL(1.0), e->x, e->y, k, n);
+    e_exp(_->exp_xy, _->xy, k, n);
+    for (int m = 0; m < n; m++) {
+        vx[m] = _->a * (y[m] - x[m]);
+        vy[m] = _->b * x[m];
+        vz[m] = exp_xy[m] - _->d * z[m];
+    }
+    e_mul(vy, - _->c, e->x, e->z, k, n);
+}
@@ -0,0 +1,54 @@
+/*
+ * Fermi-Pasta-Ulam-Tsingou alpha chain of n masses with fixed ends, q_i' = p_i, p_i' = F(q_i+1 - q_i) - F(q_i - q_i-1),
+ * with bond force F(r) = r + alpha r^2, started from the lowest mode of amplitude A at rest
+ * Variables 0 to n - 1 are the displacements q, n to 2n - 1 the momenta p
+ *
+ * Example: ./tsmn-fput-std 6:100 10 .1 10000 32 .25 1.0
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "taylor-ode.h"
+
+struct Parameters { int n; real alpha; };
+
+model *tsm_init_n (int argc, char **argv, int o, state **s) {
+    CHECK(argc == 8);
+    model *_ = malloc(sizeof (model)); CHECK(_);
+    _->n = (int)strtol(argv[5], NULL, BASE); CHECK(_->n >= 2);
+    _->alpha = STRTOR(argv[6], NULL);
+    *s = tsm_state(2 * _->n, o);
+    real amplitude = STRTOR(argv[7], NULL), PI = ACOS(-RL(1.0));
+    for (int i = 0; i < _->n; i++) (*s)->u[i * (*s)->stride] = amplitude * SIN(PI * (i + 1) / (_->n + 1));
+    return _;
+}
+
+static real _extension_ (const series q, int n, int w, int b, int j) {  // bond b joins masses b - 1 and b, the walls are -1 and n
+    return (b < n ? q[b * w + j] : RL(0.0)) - (b ? q[(b - 1) * w + j] : RL(0.0));
+}
+
+static real _force_ (const state *s, const model *_, int b, int k) {  // extensions recalculated, bonds may span two threads
+    const series q = s->u;
+    real sqr = RL(0.0);
+    for (int j = 0; j < k - j; j++) sqr += _extension_(q, _->n, s->stride, b, j) * _extension_(q, _->n, s->stride, b, k - j);
+    sqr *= RL(2.0);
+    if (k % 2 == 0) sqr += SQR(_extension_(q, _->n, s->stride, b, k / 2));
+    return _extension_(q, _->n, s->stride, b, k) + _->alpha * sqr;
+}
+
+void ode_n (series v, const state *s, const model *_, const int k, int lo, int hi) {
+    const int n = _->n, w = s->stride;
+    real left = lo > n ? _force_(s, _, lo - n, k) : RL(0.0);
+    for (int i = lo; i < hi; i++) {
+        if (i < n) {
+            v[i] = s->u[(n + i) * w + k];
+            continue;
+        }
+        if (i == n) left = _force_(s, _, 0, k);
+        real right = _force_(s, _, i - n + 1, k);  // carried over as the left bond of the next mass
+        v[i] = right - left;
+        left = right;
+    }
+}
@@ -0,0 +1,36 @@
+/*
+ * Lorenz-96 ring of n variables, x_i' = (x_i+1 - x_i-2) x_i-1 - x_i + F, started from x_i = F with x_0 nudged by .01
+ *
+ * Example: ./tsmn-lorenz96-std 6:100 10 .01 10000 40 8.0
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "taylor-ode.h"
+
+struct Parameters { real f; series d; };
+
+model *tsm_init_n (int argc, char **argv, int o, state **s) {
+    CHECK(argc == 7);
+    int n = (int)strtol(argv[5], NULL, BASE); CHECK(n >= 4);
+    *s = tsm_state(n, o);
+    int size = n * (*s)->stride;
+    arena a = tsm_arena(sizeof (model), 1, size);
+    model *_ = tsm_take(&a, sizeof (model));
+    _->d = tsm_arena_jet(&a, size);
+    _->f = STRTOR(argv[6], NULL);
+    for (int i = 0; i < n; i++) (*s)->u[i * (*s)->stride] = _->f;
+    (*s)->u[0] += RL(0.01);
+    return _;
+}
+
+void ode_n (series v, const state *s, const model *_, const int k, int lo, int hi) {
+    const int n = s->n, w = s->stride;
+    const series x = s->u, d = _->d;
+    for (int i = lo; i < hi; i++) {  // the difference x_i+1 - x_i-2 (one series each), so one product per variable
+        int next = i + 1 < n ? i + 1 : 0, back = i >= 2 ? i - 2 : i + n - 2;
+        d[i * w + k] = x[next * w + k] - x[back * w + k];
+        v[i] = t_mul(d + i * w, x + (i ? i - 1 : n - 1) * w, k) - x[i * w + k] + t_const(_->f, k);
+    }
+}
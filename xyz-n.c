@@ -0,0 +1,23 @@
+/*
+ * N-variable client methods for the 3-D models, x, y and z are variables 0, 1 and 2 (same command arguments)
+ *
+ * (c) 2018-2025 m4r35n357@gmail.com (Ian Smith), for licencing see the LICENCE file
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "taylor-ode.h"
+
+model *tsm_init_n (int argc, char **argv, int o, state **s) {
+    CHECK(argc > 8);
+    *s = tsm_state(3, o);
+    for (int i = 0; i < 3; i++) (*s)->u[i * (*s)->stride] = STRTOR(argv[5 + i], NULL);
+    return tsm_init_p(argc, argv, o);
+}
+
+void ode_n (series v, const state *s, const model *p, const int k, int lo, int hi) {
+    CHECK(!lo && hi == 3);  // the model scratch is shared by x, y and z, so never split (3 < one cache line of velocities)
+    triplet _ = ode(s->u, s->u + s->stride, s->u + 2 * s->stride, p, k);
+    v[0] = _.x;
+    v[1] = _.y;
+    v[2] = _.z;
+}